@@ -0,0 +1,118 @@
+/*
+ * BuildDurations.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *  \copyright 2026 DCBlaha.  Distributed under the GPL.
+ */
+
+#include "BuildDurations.h"
+#include "File.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+
+void BuildDurations::read(OovStringRef const filePath)
+    {
+    LockGuard lock(mMutex);
+    mFilePath = filePath;
+    mDurations.clear();
+    mTotalMs = 0;
+    mModified = false;
+    File file;
+    OovStatus status = file.open(filePath, "r");
+    if(status.ok())
+        {
+        char buf[1000];
+        while(file.getString(buf, sizeof(buf), status))
+            {
+            char *key;
+            unsigned long ms = strtoul(buf, &key, 10);
+            if(*key == ' ')
+                {
+                OovString keyStr = key+1;
+                size_t pos = keyStr.find('\n');
+                if(pos != std::string::npos)
+                    {
+                    keyStr.resize(pos);
+                    }
+                unsigned int &dur = mDurations[keyStr];
+                mTotalMs -= dur;
+                dur = static_cast<unsigned int>(ms);
+                mTotalMs += dur;
+                }
+            }
+        }
+    if(status.needReport())
+        {
+        // The durations are only used to order the work.
+        status.reported();
+        }
+    }
+
+OovStatusReturn BuildDurations::write()
+    {
+    LockGuard lock(mMutex);
+    OovStatus status(true, SC_File);
+    if(mModified && mFilePath.length() > 0)
+        {
+        File file;
+        status = file.open(mFilePath, "w");
+        if(status.ok())
+            {
+            for(auto const &dur : mDurations)
+                {
+                OovString str;
+                str.appendInt(static_cast<int>(dur.second));
+                str += ' ';
+                str += dur.first;
+                str += '\n';
+                status = file.putString(str);
+                if(!status.ok())
+                    {
+                    break;
+                    }
+                }
+            }
+        if(status.ok())
+            {
+            mModified = false;
+            }
+        }
+    return status;
+    }
+
+void BuildDurations::recordDuration(OovStringRef const key, unsigned int ms)
+    {
+    LockGuard lock(mMutex);
+    auto it = mDurations.find(key);
+    if(it != mDurations.end())
+        {
+        // Average with the previous duration to reduce the effect of
+        // a single slow run.
+        mTotalMs -= it->second;
+        it->second = (it->second + ms) / 2;
+        mTotalMs += it->second;
+        }
+    else
+        {
+        mDurations[key] = ms;
+        mTotalMs += ms;
+        }
+    mModified = true;
+    }
+
+unsigned int BuildDurations::getExpectedDuration(OovStringRef const key)
+    {
+    LockGuard lock(mMutex);
+    unsigned int ms = 0;
+    auto const &it = mDurations.find(key);
+    if(it != mDurations.end())
+        {
+        ms = it->second;
+        }
+    else if(mDurations.size() > 0)
+        {
+        ms = static_cast<unsigned int>(mTotalMs / mDurations.size());
+        }
+    return ms;
+    }
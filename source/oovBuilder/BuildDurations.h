@@ -0,0 +1,54 @@
+/*
+ * BuildDurations.h
+ *
+ *  Created on: Oct 16, 2026
+ *  \copyright 2026 DCBlaha.  Distributed under the GPL.
+ */
+
+#ifndef BUILD_DURATIONS_H_
+#define BUILD_DURATIONS_H_
+
+#include "OovString.h"
+#include "OovProcess.h"
+#include "OovError.h"
+#include <map>
+
+/// A history of how long each analysis, compile and link process took.
+/// This is used to start the longest work first so that a few large
+/// files do not end up running alone at the end of a build.
+///
+/// The durations are kept in a file so that they are available for the
+/// next build.  Each line of the file is "<milliseconds> <key>", where the
+/// key is the output file of a build process, or the source file of an
+/// analysis process.
+class BuildDurations
+    {
+    public:
+        BuildDurations():
+            mTotalMs(0), mModified(false)
+            {}
+        /// The file is optional, so a missing file is not an error.
+        void read(OovStringRef const filePath);
+        /// Only writes if a duration was recorded.
+        OovStatusReturn write();
+
+        /// This is thread safe so that it can be called by the worker threads.
+        /// @param key The output or source file name.
+        /// @param ms The duration of the process.
+        void recordDuration(OovStringRef const key, unsigned int ms);
+
+        /// Returns the recorded duration. If there is no recorded duration,
+        /// then this returns the average of all durations.
+        /// @param key The output or source file name.
+        unsigned int getExpectedDuration(OovStringRef const key);
+
+    private:
+        OovString mFilePath;
+        std::map<OovString, unsigned int> mDurations;
+        /// The total of all durations, used for the average.
+        unsigned long long mTotalMs;
+        bool mModified;
+        InProcMutex mMutex;
+    };
+
+#endif
@@ -0,0 +1,212 @@
+/*
+ * BuildTrace.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *  \copyright 2026 DCBlaha.  Distributed under the GPL.
+ */
+
+#include "BuildTrace.h"
+#include <stdio.h>
+
+
+BuildTrace sBuildTrace;
+
+static void appendJsonString(OovString &str, OovStringRef const value)
+    {
+    str += '"';
+    for(char const *p = value.getStr(); *p; p++)
+        {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if(c == '"' || c == '\\')
+            {
+            str += '\\';
+            str += *p;
+            }
+        else if(c < ' ')
+            {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            str += buf;
+            }
+        else
+            {
+            str += *p;
+            }
+        }
+    str += '"';
+    }
+
+static void appendJsonNumber(OovString &str, unsigned long long value)
+    {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%llu", value);
+    str += buf;
+    }
+
+OovStatusReturn BuildTrace::open(OovStringRef const filePath)
+    {
+    close();
+    OovStatus status = mFile.open(filePath, "w");
+    if(status.ok())
+        {
+        mStartTime = std::chrono::steady_clock::now();
+        mFirstEvent = true;
+        mWorkerQueues.clear();
+        mLaneIds.clear();
+        mNumQueueWorkers.clear();
+        status = mFile.putString("[\n");
+        LockGuard lock(mMutex);
+        getLaneId();
+        }
+    return status;
+    }
+
+void BuildTrace::close()
+    {
+    if(mFile.isOpen())
+        {
+        OovStatus status = mFile.putString("\n]\n");
+        if(status.needReport())
+            {
+            status.report(ET_Error, "Unable to write trace file");
+            }
+        mFile.close();
+        }
+    }
+
+unsigned long long BuildTrace::getTimeUs() const
+    {
+    auto elapsed = std::chrono::steady_clock::now() - mStartTime;
+    return static_cast<unsigned long long>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+
+void BuildTrace::setWorkerQueue(OovStringRef const queueName)
+    {
+    if(isOpen())
+        {
+        LockGuard lock(mMutex);
+        mWorkerQueues[std::this_thread::get_id()] = queueName;
+        }
+    }
+
+int BuildTrace::getLaneId()
+    {
+    std::thread::id threadId = std::this_thread::get_id();
+    OovString queueName;
+    auto queueIt = mWorkerQueues.find(threadId);
+    if(queueIt != mWorkerQueues.end())
+        {
+        queueName = queueIt->second;
+        }
+    // Thread ids can be reused after the threads of a queue are joined, so
+    // the lanes are found using both the queue and the thread.
+    std::pair<OovString, std::thread::id> laneKey(queueName, threadId);
+    auto it = mLaneIds.find(laneKey);
+    int id;
+    if(it == mLaneIds.end())
+        {
+        // The first thread is the one that opened the trace.
+        id = static_cast<int>(mLaneIds.size());
+        mLaneIds[laneKey] = id;
+        OovString event = "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        appendJsonNumber(event, static_cast<unsigned long long>(id));
+        event += ",\"args\":{\"name\":";
+        if(id == 0)
+            {
+            appendJsonString(event, "oovBuilder");
+            }
+        else
+            {
+            OovString name = queueName;
+            if(name.length() > 0)
+                {
+                name += ' ';
+                }
+            name += "worker ";
+            name.appendInt(++mNumQueueWorkers[queueName]);
+            appendJsonString(event, name);
+            }
+        event += "}}";
+        writeEvent(event);
+        }
+    else
+        {
+        id = it->second;
+        }
+    return id;
+    }
+
+void BuildTrace::writeEvent(OovString const &event)
+    {
+    OovString str;
+    if(!mFirstEvent)
+        {
+        str += ",\n";
+        }
+    mFirstEvent = false;
+    str += event;
+    OovStatus status = mFile.putString(str);
+    if(status.ok())
+        {
+        fflush(mFile.getFp());
+        }
+    if(status.needReport())
+        {
+        status.report(ET_Error, "Unable to write trace file");
+        }
+    }
+
+void BuildTrace::addPhaseEvent(OovStringRef const name, char phaseType)
+    {
+    if(isOpen())
+        {
+        LockGuard lock(mMutex);
+        OovString event = "{\"name\":";
+        appendJsonString(event, name);
+        event += ",\"cat\":\"phase\",\"ph\":\"";
+        event += phaseType;
+        event += "\",\"ts\":";
+        appendJsonNumber(event, getTimeUs());
+        event += ",\"pid\":1,\"tid\":";
+        appendJsonNumber(event, static_cast<unsigned long long>(getLaneId()));
+        event += "}";
+        writeEvent(event);
+        }
+    }
+
+void BuildTrace::beginPhase(OovStringRef const name)
+    {
+    addPhaseEvent(name, 'B');
+    }
+
+void BuildTrace::endPhase(OovStringRef const name)
+    {
+    addPhaseEvent(name, 'E');
+    }
+
+void BuildTrace::addProcess(OovStringRef const name, OovStringRef const category,
+    unsigned long long startUs, int exitCode)
+    {
+    if(isOpen())
+        {
+        unsigned long long endUs = getTimeUs();
+        LockGuard lock(mMutex);
+        OovString event = "{\"name\":";
+        appendJsonString(event, name);
+        event += ",\"cat\":";
+        appendJsonString(event, category);
+        event += ",\"ph\":\"X\",\"ts\":";
+        appendJsonNumber(event, startUs);
+        event += ",\"dur\":";
+        appendJsonNumber(event, endUs - startUs);
+        event += ",\"pid\":1,\"tid\":";
+        appendJsonNumber(event, static_cast<unsigned long long>(getLaneId()));
+        event += ",\"args\":{\"exitCode\":";
+        OovString exitStr;
+        exitStr.appendInt(exitCode);
+        event += exitStr;
+        event += "}}";
+        writeEvent(event);
+        }
+    }
@@ -0,0 +1,80 @@
+/*
+ * BuildTrace.h
+ *
+ *  Created on: Oct 16, 2026
+ *  \copyright 2026 DCBlaha.  Distributed under the GPL.
+ */
+
+#ifndef BUILD_TRACE_H_
+#define BUILD_TRACE_H_
+
+#include "OovString.h"
+#include "OovProcess.h"
+#include "File.h"
+#include <chrono>
+#include <thread>
+#include <map>
+
+/// Writes a timeline of the analysis and build in the trace event JSON
+/// format, which can be viewed with chrome://tracing or other trace viewers.
+/// Each process is shown in the lane of the queue worker that ran it, and
+/// the main thread shows the phases of the build.
+///
+/// Each event is written when it completes, so the file can be viewed even
+/// if the build does not finish.
+class BuildTrace
+    {
+    public:
+        BuildTrace():
+            mFirstEvent(true)
+            {}
+        ~BuildTrace()
+            { close(); }
+        /// The calling thread is shown as the main thread of the trace.
+        OovStatusReturn open(OovStringRef const filePath);
+        void close();
+        bool isOpen() const
+            { return mFile.isOpen(); }
+
+        /// Returns the time in microseconds since the trace was opened.
+        unsigned long long getTimeUs() const;
+
+        /// The phases must be nested.
+        void beginPhase(OovStringRef const name);
+        void endPhase(OovStringRef const name);
+
+        /// This is thread safe. Sets the queue of the calling worker thread,
+        /// so that the workers of each queue are shown in separate lanes.
+        /// @param queueName The name of the queue, such as analyze or build.
+        void setWorkerQueue(OovStringRef const queueName);
+
+        /// This is thread safe. The worker is found from the calling thread.
+        /// @param name The name of the output or source file of the process.
+        /// @param category The type of process, such as compile or link.
+        /// @param startUs The time from getTimeUs when the process started.
+        /// @param exitCode The exit code of the process.
+        void addProcess(OovStringRef const name, OovStringRef const category,
+            unsigned long long startUs, int exitCode);
+
+    private:
+        File mFile;
+        std::chrono::steady_clock::time_point mStartTime;
+        InProcMutex mMutex;
+        /// The queue names of the worker threads.
+        std::map<std::thread::id, OovString> mWorkerQueues;
+        /// The lane ids of the queue workers.
+        std::map<std::pair<OovString, std::thread::id>, int> mLaneIds;
+        /// The number of workers that were shown for each queue.
+        std::map<OovString, int> mNumQueueWorkers;
+        bool mFirstEvent;
+
+        /// The mutex must be locked before calling this.
+        int getLaneId();
+        /// The mutex must be locked before calling this.
+        void writeEvent(OovString const &event);
+        void addPhaseEvent(OovStringRef const name, char phaseType);
+    };
+
+extern BuildTrace sBuildTrace;
+
+#endif
@@ -0,0 +1,279 @@
+/*
+ * CompileCache.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *  \copyright 2026 DCBlaha.  Distributed under the GPL.
+ */
+
+#include "CompileCache.h"
+#include "File.h"
+#include <stdio.h>
+
+
+static const uint64_t FnvOffsetBasis = 14695981039346656037ULL;
+static const uint64_t FnvPrime = 1099511628211ULL;
+
+static void hashBytes(uint64_t &hash, void const *data, size_t size)
+    {
+    unsigned char const *bytes = static_cast<unsigned char const*>(data);
+    for(size_t i=0; i<size; i++)
+        {
+        hash ^= bytes[i];
+        hash *= FnvPrime;
+        }
+    }
+
+// The terminating null is included so that adjacent strings can not run
+// together to make the same hash.
+static void hashString(uint64_t &hash, OovStringRef const str)
+    {
+    hashBytes(hash, str.getStr(), str.numBytes() + 1);
+    }
+
+static void hashValue(uint64_t &hash, uint64_t val)
+    {
+    hashBytes(hash, &val, sizeof(val));
+    }
+
+static OovStatusReturn copyFile(OovStringRef const srcPath, OovStringRef const dstPath)
+    {
+    File srcFile;
+    File dstFile;
+    OovStatus status = srcFile.open(srcPath, "rb");
+    if(status.ok())
+        {
+        status = dstFile.open(dstPath, "wb");
+        }
+    if(status.ok())
+        {
+        char buf[0x10000];
+        size_t size;
+        while((size = fread(buf, 1, sizeof(buf), srcFile.getFp())) > 0)
+            {
+            status = dstFile.write(buf, static_cast<int>(size));
+            if(!status.ok())
+                {
+                break;
+                }
+            }
+        if(status.ok())
+            {
+            status.set(ferror(srcFile.getFp()) == 0, SC_File);
+            }
+        }
+    return status;
+    }
+
+void CompileCache::setCacheDir(OovStringRef const cacheDir)
+    {
+    if(cacheDir.numBytes() > 0)
+        {
+        mCacheDir.setPath(cacheDir, FP_Dir);
+        }
+    else
+        {
+        mCacheDir.clear();
+        }
+    mFileHashes.clear();
+    }
+
+bool CompileCache::getFileHash(OovStringRef const filePath, uint64_t &hash)
+    {
+    bool success = true;
+    auto const &it = mFileHashes.find(filePath);
+    if(it != mFileHashes.end())
+        {
+        hash = it->second;
+        }
+    else
+        {
+        File file;
+        OovStatus status = file.open(filePath, "rb");
+        if(status.ok())
+            {
+            hash = FnvOffsetBasis;
+            char buf[0x10000];
+            size_t size;
+            while((size = fread(buf, 1, sizeof(buf), file.getFp())) > 0)
+                {
+                hashBytes(hash, buf, size);
+                }
+            success = (ferror(file.getFp()) == 0);
+            }
+        else
+            {
+            success = false;
+            }
+        if(status.needReport())
+            {
+            // A missing file is not an error, the file is just not cached.
+            status.reported();
+            }
+        if(success)
+            {
+            mFileHashes[filePath] = hash;
+            }
+        }
+    return success;
+    }
+
+OovString const &CompileCache::findCompilerPath(OovStringRef const compiler)
+    {
+    auto it = mCompilerPaths.find(compiler);
+    if(it == mCompilerPaths.end())
+        {
+        OovString compilerPath = compiler;
+        if(FilePathGetPosLeftPathSep(compiler, compiler.numBytes(),
+            RP_RetPosFailure) == std::string::npos)
+            {
+#ifdef __linux__
+            char const pathDelimiter = ':';
+#else
+            char const pathDelimiter = ';';
+#endif
+            OovStatus status(true, SC_File);
+            for(auto const &dir : StringSplit(GetEnv("PATH").getStr(), pathDelimiter))
+                {
+                FilePath path(dir, FP_Dir);
+                path.appendFile(compiler);
+#ifndef __linux__
+                if(!path.hasExtension())
+                    {
+                    path += ".exe";
+                    }
+#endif
+                if(FileIsFileOnDisk(path, status))
+                    {
+                    compilerPath = path;
+                    break;
+                    }
+                }
+            if(status.needReport())
+                {
+                // A missing compiler is reported when the compiler is run.
+                status.reported();
+                }
+            }
+        it = mCompilerPaths.insert(std::make_pair(OovString(compiler),
+            compilerPath)).first;
+        }
+    return it->second;
+    }
+
+OovString CompileCache::makeCacheFilePath(OovStringRef const srcFile,
+    OovStringVec const &incFiles, OovProcessChildArgs const &args)
+    {
+    OovString cacheFilePath;
+    uint64_t key = FnvOffsetBasis;
+    char const * const *argv = args.getArgv();
+    for(size_t i=0; i<args.getArgc(); i++)
+        {
+        hashString(key, argv[i]);
+        }
+    // Include the compiler itself so that a compiler update does not reuse
+    // old object files.
+    time_t compilerTime = 0;
+    size_t compilerSize = 0;
+    if(args.getArgc() > 0)
+        {
+        OovStatus status = FileGetFileTimeSize(findCompilerPath(argv[0]),
+            compilerTime, compilerSize);
+        if(status.needReport())
+            {
+            // The compiler is not hashed, but the arguments still are.
+            status.reported();
+            }
+        }
+    hashValue(key, static_cast<uint64_t>(compilerTime));
+    hashValue(key, compilerSize);
+
+    uint64_t fileHash = 0;
+    bool success = getFileHash(srcFile, fileHash);
+    if(success)
+        {
+        hashValue(key, fileHash);
+        for(auto const &incFile : incFiles)
+            {
+            success = getFileHash(incFile, fileHash);
+            if(!success)
+                {
+                break;
+                }
+            hashString(key, incFile);
+            hashValue(key, fileHash);
+            }
+        }
+    if(success)
+        {
+        char keyStr[20];
+        snprintf(keyStr, sizeof(keyStr), "%016llx",
+            static_cast<unsigned long long>(key));
+        cacheFilePath = mCacheDir;
+        cacheFilePath += keyStr;
+        cacheFilePath += ".o";
+        }
+    return cacheFilePath;
+    }
+
+bool CompileCache::retrieve(OovStringRef const cacheFilePath,
+    OovStringRef const outFile)
+    {
+    OovStatus status(true, SC_File);
+    bool hit = FileIsFileOnDisk(cacheFilePath, status);
+    if(hit)
+        {
+        FilePath outDir(outFile, FP_File);
+        outDir.discardFilename();
+        status = FileEnsurePathExists(outDir);
+        if(status.ok())
+            {
+            status = copyFile(cacheFilePath, outFile);
+            }
+        if(!status.ok())
+            {
+            // Remove any partial output so that the compiler will be run.
+            OovStatus delStatus = FileDelete(outFile);
+            if(delStatus.needReport())
+                {
+                delStatus.reported();
+                }
+            hit = false;
+            }
+        }
+    if(status.needReport())
+        {
+        OovString err = "Unable to use compile cache file ";
+        err += cacheFilePath;
+        status.report(ET_Info, err);
+        }
+    return hit;
+    }
+
+OovStatusReturn CompileCache::store(OovStringRef const outFile,
+    OovStringRef const cacheFilePath)
+    {
+    FilePath cacheDir(cacheFilePath, FP_File);
+    cacheDir.discardFilename();
+    OovStatus status = FileEnsurePathExists(cacheDir);
+    // Copy to a temporary file so that another build never sees a partial
+    // object file.
+    OovString tempPath = cacheFilePath;
+    tempPath += ".tmp";
+    if(status.ok())
+        {
+        status = copyFile(outFile, tempPath);
+        }
+    if(status.ok())
+        {
+        status = FileRename(tempPath, cacheFilePath);
+        }
+    if(!status.ok())
+        {
+        OovStatus delStatus = FileDelete(tempPath);
+        if(delStatus.needReport())
+            {
+            delStatus.reported();
+            }
+        }
+    return status;
+    }
@@ -0,0 +1,66 @@
+/*
+ * CompileCache.h
+ *
+ *  Created on: Oct 16, 2026
+ *  \copyright 2026 DCBlaha.  Distributed under the GPL.
+ */
+
+#ifndef COMPILE_CACHE_H_
+#define COMPILE_CACHE_H_
+
+#include "OovString.h"
+#include "OovProcessArgs.h"
+#include "FilePath.h"
+#include <stdint.h>
+#include <map>
+
+/// A local cache of compiled object files. The key of an object file is a
+/// hash of the contents of the source file and all of its nested include
+/// files, the compiler arguments and the compiler file time and size. This
+/// allows an object file to be reused after a clean, or after a file is
+/// touched or changed back, without running the compiler.
+///
+/// The include files are the ones found during analysis, so a change to an
+/// include file that is not in the include map is not detected.
+class CompileCache
+    {
+    public:
+        /// An empty directory disables the cache.
+        void setCacheDir(OovStringRef const cacheDir);
+        bool isEnabled() const
+            { return(mCacheDir.length() > 0); }
+
+        /// Returns the path of the cached object file, or an empty string if
+        /// any of the files cannot be read.
+        /// This is not thread safe since it caches the file hashes.
+        /// @param srcFile The source file to compile.
+        /// @param incFiles The nested include files used by the source file.
+        /// @param args The compiler arguments. These must not include the
+        ///     output file name.
+        OovString makeCacheFilePath(OovStringRef const srcFile,
+            OovStringVec const &incFiles, OovProcessChildArgs const &args);
+
+        /// Copies the cached object file to the output file.
+        /// Returns true if the cached object file existed.
+        static bool retrieve(OovStringRef const cacheFilePath,
+            OovStringRef const outFile);
+
+        /// Copies the output file into the cache. This is called from
+        /// the worker threads after a successful compile.
+        static OovStatusReturn store(OovStringRef const outFile,
+            OovStringRef const cacheFilePath);
+
+    private:
+        FilePath mCacheDir;
+        /// The content hashes of the files that were already read.
+        std::map<OovString, uint64_t> mFileHashes;
+        /// The compiler file paths that were already found using the PATH.
+        std::map<OovString, OovString> mCompilerPaths;
+
+        bool getFileHash(OovStringRef const filePath, uint64_t &hash);
+        /// Returns the file path of the compiler. A compiler name without a
+        /// directory is searched for in the PATH environment variable.
+        OovString const &findCompilerPath(OovStringRef const compiler);
+    };
+
+#endif
@@ -8,10 +8,12 @@
 #include "ComponentBuilder.h"
 #include "srcFileParser.h"
 #include "ObjSymbols.h"
+#include "BuildTrace.h"
 #include "File.h"
 #include <stdio.h>
 #include <sys/stat.h>
 #include <algorithm>
+#include <chrono>
 
 TaskQueueListener::~TaskQueueListener()
     {}
@@ -45,7 +47,9 @@ void ComponentBuilder::build(eProcessModes mode, OovStringRef const incDepsFileP
     if(mode == PM_CovInstr)
         {
         sVerboseDump.logProgress("Instrument source");
+        sBuildTrace.beginPhase("instrument");
         processSourceForComponents(PM_CovInstr);
+        sBuildTrace.endPhase("instrument");
         }
     else
         {
@@ -99,7 +103,9 @@ void ComponentBuilder::makeOrderedPackageLibs(OovStringRef const compName)
 
                 didAnything = true;
                 OovStringVec libNames = pkg.getScannedLibraryFilePaths();
-                makeLibSymbols(pkg.getPkgName(), libNames);
+                makeLibSymbols(pkg.getPkgName(), libNames,
+                    mComponentFinder.getProjectBuildArgs().getObjSymbolPath(),
+                    getSymbolBasePath(), *this, getNumHardwareThreads());
                 mObjSymbols.appendOrderedLibs(pkg.getPkgName(),
                         getSymbolBasePath(), libDirs, sortedLibNames);
 
@@ -204,22 +210,127 @@ IndexedStringSet ComponentBuilder::getComponentPackageLinkArgs(OovStringRef cons
     return linkArgs;
     }
 
+size_t BuildStepGraph::addStep(StartFunc const &startFunc,
+    std::vector<size_t> const &prereqStepIds, unsigned int expectedMs)
+    {
+    size_t stepId = mSteps.size();
+    Step step;
+    step.mStartFunc = startFunc;
+    step.mNumWaiting = prereqStepIds.size();
+    step.mExpectedMs = expectedMs;
+    step.mPathMs = 0;
+    mSteps.push_back(step);
+    for(auto const &prereqId : prereqStepIds)
+        {
+        mSteps[prereqId].mDependentIds.push_back(stepId);
+        }
+    return stepId;
+    }
+
+void BuildStepGraph::computePaths()
+    {
+    for(size_t i=mSteps.size(); i>0; i--)
+        {
+        Step &step = mSteps[i-1];
+        unsigned long long longestDepMs = 0;
+        for(auto const &depId : step.mDependentIds)
+            {
+            longestDepMs = std::max(longestDepMs, mSteps[depId].mPathMs);
+            }
+        step.mPathMs = step.mExpectedMs + longestDepMs;
+        }
+    }
+
+void BuildStepGraph::run()
+    {
+    computePaths();
+    mQueue.setStepGraph(this);
+    mQueue.setupQueue(mQueue.getNumHardwareThreads());
+    std::unique_lock<std::mutex> lock(mStepMutex);
+    for(size_t i=0; i<mSteps.size(); i++)
+        {
+        if(mSteps[i].mNumWaiting == 0)
+            {
+            mReadySteps.push(ReadyStep(mSteps[i].mPathMs, i));
+            }
+        }
+    while(mNumComplete < mSteps.size())
+        {
+        if(mReadySteps.size() > 0)
+            {
+            size_t stepId = mReadySteps.top().mStepId;
+            mReadySteps.pop();
+            // The start function may block while adding a task to the queue,
+            // so the lock must be released so that the workers can complete steps.
+            lock.unlock();
+            bool queued = false;
+            if(mSteps[stepId].mStartFunc)
+                {
+                queued = mSteps[stepId].mStartFunc(stepId);
+                }
+            lock.lock();
+            if(!queued)
+                {
+                stepCompleteLocked(stepId);
+                }
+            }
+        else
+            {
+            mStepCompleteSignal.wait(lock);
+            }
+        }
+    lock.unlock();
+    mQueue.waitForCompletion();
+    mQueue.setStepGraph(nullptr);
+    }
+
+void BuildStepGraph::stepComplete(size_t stepId)
+    {
+    std::unique_lock<std::mutex> lock(mStepMutex);
+    stepCompleteLocked(stepId);
+    lock.unlock();
+    mStepCompleteSignal.notify_one();
+    }
+
+void BuildStepGraph::stepCompleteLocked(size_t stepId)
+    {
+    mNumComplete++;
+    for(auto const &depId : mSteps[stepId].mDependentIds)
+        {
+        if(--mSteps[depId].mNumWaiting == 0)
+            {
+            mReadySteps.push(ReadyStep(mSteps[depId].mPathMs, depId));
+            }
+        }
+    }
+
+/// Finds whether any of the project libraries were built successfully.
 class LibTaskListener:public TaskQueueListener
     {
     public:
-        OovStringVec const &getBuiltLibs() const
-            { return mBuiltLibs; }
+        LibTaskListener():
+            mAnyLibsBuilt(false)
+            {}
+        bool anyLibsBuilt()
+            {
+            LockGuard lock(mMutex);
+            return mAnyLibsBuilt;
+            }
     private:
-        OovStringVec mBuiltLibs;
+        InProcMutex mMutex;
+        bool mAnyLibsBuilt;
         virtual void extraProcessing(bool success, OovStringRef const outFile,
-                OovStringRef const /*stdOutFn*/, ProcessArgs const & /*item*/) override;
+                OovStringRef const stdOutFn, ProcessArgs const &item) override;
     };
 
-void LibTaskListener::extraProcessing(bool success, OovStringRef const outFile,
-    OovStringRef const /*stdOutFn*/, ProcessArgs const & /*item*/)
+void LibTaskListener::extraProcessing(bool success, OovStringRef const /*outFile*/,
+    OovStringRef const /*stdOutFn*/, ProcessArgs const &item)
     {
-    if(success)
-        mBuiltLibs.push_back(outFile);
+    if(success && item.mIsProjectLib)
+        {
+        LockGuard lock(mMutex);
+        mAnyLibsBuilt = true;
+        }
     }
 
 void ComponentBuilder::processSourceForComponents(eProcessModes pm)
@@ -250,23 +361,7 @@ void ComponentBuilder::processSourceForComponents(eProcessModes pm)
 
                 for(const auto &src : cppSources)
                     {
-                    FilePath absSrc;
-                    absSrc.getAbsolutePath(src, FP_File);
-                    OovStringVec orderedCompIncRoots = mComponentFinder.getFileIncludeDirs(src);
-                    OovStringVec orderedIncDirs =
-                        mIncDirMap.getOrderedIncludeDirsForSourceFile(absSrc,
-                        orderedCompIncRoots);
-                    /// @todo - this could be optimized to not check file times of external files.
-                    /// @todo - more optimization could use the times in the incdeps file.
-                    std::set<IncludedPath> incFilesSet;
-                    mIncDirMap.getNestedIncludeFilesUsedBySourceFile(absSrc,
-                        incFilesSet);
-                    OovStringVec incFiles;
-                    for(auto const &file : incFilesSet)
-                        {
-                        incFiles.push_back(file.getFullPath());
-                        }
-                    processCppSourceFile(pm, src, orderedIncDirs, incFiles, compileArgs);
+                    processCppSourceFile(pm, src, compileArgs);
                     }
                 }
             if(compType == CT_JavaJarLib || compType == CT_JavaJarProg)
@@ -349,72 +444,144 @@ void ComponentBuilder::buildComponents()
     ComponentDefinitions comps = compTypesFile.getDefinedComponents();
 
     sVerboseDump.logProgress("Generating package dependencies");
+    sBuildTrace.beginPhase("generateDependencies");
     generateDependencies();
-    sVerboseDump.logProgress("Compile objects");
-    // Compile all objects.
-    processSourceForComponents(PM_Build);
-    sVerboseDump.logProgress("Build libraries");
-
-    // Build all project libraries
-    OovStringVec builtLibFileNames;
-    OovStringVec allLibFileNames;
+    sBuildTrace.endPhase("generateDependencies");
+
+    // Many source files include the same headers, so read the times of all
+    // source and included files once.
+    sVerboseDump.logProgress("Read file times");
+    sBuildTrace.beginPhase("fileTimes");
+    std::set<OovString> allFiles = mIncDirMap.getAllFiles();
+    mSourceFileTimes.readFileTimes(OovStringVec(allFiles.begin(), allFiles.end()));
+    sBuildTrace.endPhase("fileTimes");
+
+    // The external package libraries do not depend on anything in the
+    // project, so they are ordered before any project steps are started.
     if(comps.size() > 0)
         {
-        LibTaskListener libListener;
-        setTaskListener(&libListener);
-        setupQueue(getNumHardwareThreads());
+        sVerboseDump.logProgress("Order external package libraries");
+        sBuildTrace.beginPhase("symbols");
         for(const auto &compDef : comps)
             {
-            if(compDef.getCompType() == CT_StaticLib)
-                {
-                OovStringVec sources = scannedInfoFile.getComponentFiles(
-                    compTypesFile, ScannedComponentInfo::CFT_CppSource, compDef.getCompName());
-                for(size_t i=0; i<sources.size(); i++)
-                    {
-                    sources[i] = makeOutputObjectFileName(sources[i]);
-                    }
-                if(sources.size() > 0)
-                    {
-                    allLibFileNames.push_back(makeLibFn(compDef.getCompName()));
-                    makeLib(compDef.getCompName(), sources);
-                    }
-                }
+            makeOrderedPackageLibs(compDef.getCompName());
             }
-        waitForCompletion();
-        builtLibFileNames = libListener.getBuiltLibs();
-        setTaskListener(nullptr);
-
-        if(builtLibFileNames.size() > 0)
-           {
-           makeLibSymbols("ProjLibs", allLibFileNames);
-           }
+        sBuildTrace.endPhase("symbols");
         }
 
+    sVerboseDump.logProgress("Build components");
+    mBuildDurations.read(Project::getBuildDurationsFilePath());
+    setDurations(&mBuildDurations);
+    BuildStepGraph graph(*this);
 
-    // Build programs
-    OovStringVec projectLibFileNames;
-    mObjSymbols.appendOrderedLibFileNames("ProjLibs", getSymbolBasePath(),
-            projectLibFileNames);
-    if(comps.size() > 0)
+    // Compile all objects. These do not depend on any other steps.
+    std::map<OovString, std::vector<size_t>> compCompileStepIds;
+    for(const auto &name : scannedInfoFile.getComponentNames())
         {
-        sVerboseDump.logProgress("Order external package libraries");
+        eCompTypes compType = compTypesFile.getComponentType(name);
+        if(compType != CT_Unknown && compType != CT_JavaJarLib &&
+            compType != CT_JavaJarProg)
+            {
+            OovStringSet compileArgs = getComponentPackageCompileArgs(name);
+            OovStringVec cppSources = scannedInfoFile.getComponentFiles(
+                compTypesFile, ScannedComponentInfo::CFT_CppSource, name);
+            for(const auto &src : cppSources)
+                {
+                compCompileStepIds[name].push_back(graph.addStep(
+                    [this, src, compileArgs](size_t stepId) -> bool
+                    { return processCppSourceFile(PM_Build, src, compileArgs, stepId); },
+                    std::vector<size_t>(), mBuildDurations.getExpectedDuration(
+                    makeOutputObjectFileName(src))));
+                }
+            }
+        if(compType == CT_JavaJarLib || compType == CT_JavaJarProg)
+            {
+            OovStringVec javaSources = scannedInfoFile.getComponentFiles(
+                compTypesFile, ScannedComponentInfo::CFT_JavaSource, name);
+            compCompileStepIds[name].push_back(graph.addStep(
+                [this, name, javaSources](size_t stepId) -> bool
+                { return processJavaSourceFiles(PM_Build, name, javaSources, stepId); }
+                ));
+            }
+        }
 
-        for(const auto &compDef : comps)
+    // Each project library is built as soon as its own objects are compiled.
+    OovStringVec allLibFileNames;
+    std::vector<size_t> libStepIds;
+    LibTaskListener libListener;
+    for(const auto &compDef : comps)
+        {
+        if(compDef.getCompType() == CT_StaticLib)
             {
-            makeOrderedPackageLibs(compDef.getCompName());
+            OovString const &name = compDef.getCompName();
+            OovStringVec sources = scannedInfoFile.getComponentFiles(
+                compTypesFile, ScannedComponentInfo::CFT_CppSource, name);
+            for(size_t i=0; i<sources.size(); i++)
+                {
+                sources[i] = makeOutputObjectFileName(sources[i]);
+                }
+            if(sources.size() > 0)
+                {
+                allLibFileNames.push_back(makeLibFn(name));
+                libStepIds.push_back(graph.addStep(
+                    [this, name, sources](size_t stepId) -> bool
+                    { return makeLib(name, sources, stepId); },
+                    compCompileStepIds[name],
+                    mBuildDurations.getExpectedDuration(makeLibFn(name))));
+                }
             }
+        }
 
-        sVerboseDump.logProgress("Build programs ");
+    // The project library symbols require all project libraries. This is
+    // run by a worker in the builder queue so that the graph can start other
+    // steps. The symbols are read using one thread since the other
+    // workers are busy with other steps. The graph thread may be changing
+    // the component configuration, so the task only uses values that are
+    // found by the start function.
+    OovStringVec projectLibFileNames;
+    OovString libSymbolsTaskName = getSymbolBasePath() + "ProjLibs";
+    size_t libSymbolsStepId = graph.addStep(
+        [this, &allLibFileNames, &libListener, &projectLibFileNames,
+        libSymbolsTaskName](size_t stepId) -> bool
+        {
+        OovString objSymbolTool = mComponentFinder.getProjectBuildArgs().getObjSymbolPath();
+        OovString symbolBasePath = getSymbolBasePath();
+        ProcessArgs procArgs;
+        procArgs.mOutputFile = libSymbolsTaskName;
+        procArgs.mStepId = stepId;
+        procArgs.mTraceCategory = "symbols";
+        procArgs.mTaskFunc = [this, &allLibFileNames, &libListener,
+            &projectLibFileNames, objSymbolTool, symbolBasePath]() -> bool
+            {
+            if(libListener.anyLibsBuilt())
+                {
+                ComponentTaskQueue symbolQueue("symbols");
+                makeLibSymbols("ProjLibs", allLibFileNames, objSymbolTool,
+                    symbolBasePath, symbolQueue, 1);
+                }
+            return mObjSymbols.appendOrderedLibFileNames("ProjLibs",
+                symbolBasePath, projectLibFileNames);
+            };
+        addTask(procArgs);
+        return true;
+        }, libStepIds, mBuildDurations.getExpectedDuration(libSymbolsTaskName));
 
-        setupQueue(getNumHardwareThreads());
-        for(const auto &compDef : comps)
+    // Each program is linked as soon as its objects are compiled and
+    // the project libraries are ordered.
+    std::vector<size_t> jarLibStepIds;
+    for(const auto &compDef : comps)
+        {
+        OovString const &name = compDef.getCompName();
+        auto type = compTypesFile.getComponentType(name);
+        if(type == CT_Program || type == CT_SharedLib)
             {
-            OovString const &name = compDef.getCompName();
-            OovStringVec externalLibDirs;       // not in library search order, eliminate dups.
-            IndexedStringVec externalOrderedPackageLibNames;
-            auto type = compTypesFile.getComponentType(name);
-            if(type == CT_Program || type == CT_SharedLib)
+            std::vector<size_t> prereqIds = compCompileStepIds[name];
+            prereqIds.push_back(libSymbolsStepId);
+            graph.addStep([this, name, type, &compTypesFile, &scannedInfoFile,
+                &projectLibFileNames](size_t stepId) -> bool
                 {
+                OovStringVec externalLibDirs;       // not in library search order, eliminate dups.
+                IndexedStringVec externalOrderedPackageLibNames;
                 appendOrderedPackageLibs(name, externalLibDirs,
                         externalOrderedPackageLibNames);
                 IndexedStringSet compPkgLinkArgs = getComponentPackageLinkArgs(name,
@@ -422,23 +589,49 @@ void ComponentBuilder::buildComponents()
 
                 OovStringVec sources = scannedInfoFile.getComponentFiles(
                     compTypesFile, ScannedComponentInfo::CFT_CppSource, name);
-                makeExe(name, sources, projectLibFileNames,
+                return makeExe(name, sources, projectLibFileNames,
                         externalLibDirs, externalOrderedPackageLibNames,
-                        compPkgLinkArgs, type == CT_SharedLib);
-                }
+                        compPkgLinkArgs, type == CT_SharedLib, stepId);
+                }, prereqIds, mBuildDurations.getExpectedDuration(
+                makeExeFn(name, type == CT_SharedLib)));
             }
-        for(const auto &compDef : comps)
+        else if(type == CT_JavaJarLib)
             {
-            auto type = compTypesFile.getComponentType(compDef.getCompName());
-            if(type == CT_JavaJarLib || type == CT_JavaJarProg)
-                {
-                bool prog = (type == CT_JavaJarProg);
-                OovStringVec sources = scannedInfoFile.getComponentFiles(
-                    compTypesFile, ScannedComponentInfo::CFT_JavaSource, compDef.getCompName());
-                makeJar(compDef.getCompName(), sources, prog);
-                }
+            OovStringVec sources = scannedInfoFile.getComponentFiles(
+                compTypesFile, ScannedComponentInfo::CFT_JavaSource, name);
+            jarLibStepIds.push_back(graph.addStep(
+                [this, name, sources](size_t stepId) -> bool
+                { return makeJar(name, sources, false, stepId); },
+                compCompileStepIds[name],
+                mBuildDurations.getExpectedDuration(makeOutputJarName(name))));
+            }
+        }
+    // Program jars use all of the library jars in the project.
+    for(const auto &compDef : comps)
+        {
+        OovString const &name = compDef.getCompName();
+        if(compTypesFile.getComponentType(name) == CT_JavaJarProg)
+            {
+            std::vector<size_t> prereqIds = compCompileStepIds[name];
+            prereqIds.insert(prereqIds.end(), jarLibStepIds.begin(), jarLibStepIds.end());
+            OovStringVec sources = scannedInfoFile.getComponentFiles(
+                compTypesFile, ScannedComponentInfo::CFT_JavaSource, name);
+            graph.addStep([this, name, sources](size_t stepId) -> bool
+                { return makeJar(name, sources, true, stepId); },
+                prereqIds, mBuildDurations.getExpectedDuration(
+                makeOutputJarName(name)));
             }
-        waitForCompletion();
+        }
+    sBuildTrace.beginPhase("build");
+    setTaskListener(&libListener);
+    graph.run();
+    setTaskListener(nullptr);
+    sBuildTrace.endPhase("build");
+    setDurations(nullptr);
+    OovStatus status = mBuildDurations.write();
+    if(status.needReport())
+        {
+        status.report(ET_Error, "Unable to write build durations");
         }
     sVerboseDump.logProgress("Done building");
     }
@@ -447,7 +640,7 @@ void ComponentBuilder::buildComponents()
 bool ComponentTaskQueue::runProcess(OovStringRef const procPath,
     OovStringRef const outFile, const OovProcessChildArgs &args,
     InProcMutex &listenerMutex, OovStringRef const stdOutFn,
-    OovStringRef const workingDir)
+    OovStringRef const workingDir, OovStringRef const traceCategory)
     {
     FilePath outDir(outFile, FP_File);
     outDir.discardFilename();
@@ -482,9 +675,12 @@ bool ComponentTaskQueue::runProcess(OovStringRef const procPath,
             listener.setStdOut(sVerboseDump.getFp(), OovProcessStdListener::OP_OutputStdAndFile);
             }
 */
-        int exitCode;
+        int exitCode = -1;
         OovPipeProcess pipeProc;
+        unsigned long long startUs = sBuildTrace.getTimeUs();
         success = pipeProc.spawn(procPath, args.getArgv(), listener, exitCode, workingDir);
+        sBuildTrace.addProcess(outFile, traceCategory ? traceCategory : "process",
+            startUs, exitCode);
         if(!success)
             fprintf(stderr, "OovBuilder: Unable to execute process %s\n", procPath.getStr());
         if(!success || exitCode != 0)
@@ -509,16 +705,53 @@ bool ComponentTaskQueue::runProcess(OovStringRef const procPath,
 
 bool ComponentTaskQueue::processItem(ProcessArgs const &item)
     {
+    sBuildTrace.setWorkerQueue(mTraceQueueName);
     char const *stdOutFn = item.mStdOutFn.length() ? item.mStdOutFn.getStr() : nullptr;
     char const *workingDir = nullptr;
     if(item.mWorkingDir.length() > 0)
         {
         workingDir = item.mWorkingDir.getStr();
         }
-    bool success = runProcess(item.mProcess, item.mOutputFile,
-        item.mChildArgs, mListenerStdMutex, stdOutFn, workingDir);
+    auto startTime = std::chrono::steady_clock::now();
+    char const *traceCategory = nullptr;
+    if(item.mTraceCategory.length() > 0)
+        {
+        traceCategory = item.mTraceCategory.getStr();
+        }
+    bool success;
+    if(item.mTaskFunc)
+        {
+        unsigned long long startUs = sBuildTrace.getTimeUs();
+        success = item.mTaskFunc();
+        sBuildTrace.addProcess(item.mOutputFile, traceCategory ? traceCategory : "task",
+            startUs, success ? 0 : -1);
+        }
+    else
+        {
+        success = runProcess(item.mProcess, item.mOutputFile,
+            item.mChildArgs, mListenerStdMutex, stdOutFn, workingDir, traceCategory);
+        }
+    if(success && mDurations)
+        {
+        auto elapsed = std::chrono::steady_clock::now() - startTime;
+        mDurations->recordDuration(item.mOutputFile, static_cast<unsigned int>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()));
+        }
+    if(success && item.mCacheFilePath.length() > 0)
+        {
+        OovStatus status = CompileCache::store(item.mOutputFile, item.mCacheFilePath);
+        if(status.needReport())
+            {
+            // The cache is optional, so the build continues.
+            OovString err = "Unable to store compile cache file ";
+            err += item.mCacheFilePath;
+            status.report(ET_Info, err);
+            }
+        }
     if(mListener)
         mListener->extraProcessing(success, item.mOutputFile, stdOutFn, item);
+    if(mStepGraph && item.mStepId != ProcessArgs::NoStepId)
+        mStepGraph->stepComplete(item.mStepId);
     return success;
     }
 
@@ -530,10 +763,21 @@ OovString ComponentBuilder::makeOutputObjectFileName(OovStringRef const srcFile)
     return outFileName;
     }
 
-void ComponentBuilder::processCppSourceFile(eProcessModes pm, OovStringRef const srcFile,
-        OovStringVec const &incDirs, OovStringVec const &incFiles,
-        OovStringSet const &externPkgCompileArgs)
+OovString ComponentBuilder::makeExeFn(OovStringRef const compName, bool shared)
     {
+    OovString exeName = mComponentFinder.makeActualComponentName(compName);
+    OovString outFileName = mOutputPath + exeName;
+    if(shared)
+        outFileName += ".so";
+    else
+        outFileName = FilePathMakeExeFilename(outFileName);
+    return outFileName;
+    }
+
+bool ComponentBuilder::processCppSourceFile(eProcessModes pm, OovStringRef const srcFile,
+        OovStringSet const &externPkgCompileArgs, size_t stepId)
+    {
+    bool queued = false;
     bool processFile = isCppSource(srcFile);
     if(pm == PM_CovInstr && !processFile)
         {
@@ -541,6 +785,21 @@ void ComponentBuilder::processCppSourceFile(eProcessModes pm, OovStringRef const
         }
     if(processFile)
         {
+        FilePath absSrc;
+        absSrc.getAbsolutePath(srcFile, FP_File);
+        OovStringVec orderedCompIncRoots = mComponentFinder.getFileIncludeDirs(srcFile);
+        OovStringVec incDirs = mIncDirMap.getOrderedIncludeDirsForSourceFile(absSrc,
+            orderedCompIncRoots);
+        /// @todo - this could be optimized to not check file times of external files.
+        /// @todo - more optimization could use the times in the incdeps file.
+        std::set<IncludedPath> incFilesSet;
+        mIncDirMap.getNestedIncludeFilesUsedBySourceFile(absSrc, incFilesSet);
+        OovStringVec incFiles;
+        for(auto const &file : incFilesSet)
+            {
+            incFiles.push_back(file.getFullPath());
+            }
+
         static size_t BadIndex = static_cast<size_t>(-1);
         size_t incFileOlderIndex = BadIndex;
         OovString outFileName;
@@ -553,8 +812,8 @@ void ComponentBuilder::processCppSourceFile(eProcessModes pm, OovStringRef const
             outFileName = makeOutputObjectFileName(srcFile);
             }
         OovStatus status(true, SC_File);
-        if(FileStat::isOutputOld(outFileName, srcFile, status) ||
-                FileStat::isOutputOld(outFileName, incFiles, status, &incFileOlderIndex))
+        if(mSourceFileTimes.isOutputOld(outFileName, srcFile, status) ||
+                mSourceFileTimes.isOutputOld(outFileName, incFiles, status, &incFileOlderIndex))
             {
             OovString ownerComp = getComponentTypesFile().getComponentNameOwner(srcFile);
             mComponentFinder.setCompConfig(ownerComp);
@@ -581,21 +840,43 @@ void ComponentBuilder::processCppSourceFile(eProcessModes pm, OovStringRef const
                 {
                 ca.addArg(arg);
                 }
-            ca.addArg("-o");
-            ca.addArg(outFileName);
-
-            sVerboseDump.logProcess(srcFile, ca.getArgv(), static_cast<int>(ca.getArgc()));
-            addTask(ProcessArgs(procPath, outFileName, ca));
+            // The output file name is not part of the cache key.
+            OovString cacheFilePath;
+            if(pm != PM_CovInstr && mCompileCache.isEnabled())
+                {
+                cacheFilePath = mCompileCache.makeCacheFilePath(srcFile, incFiles, ca);
+                }
+            if(cacheFilePath.length() > 0 &&
+                    CompileCache::retrieve(cacheFilePath, outFileName))
+                {
+                printf("oovBuilder Cached %s\n", outFileName.getStr());
+                fflush(stdout);
+                }
+            else
+                {
+                ca.addArg("-o");
+                ca.addArg(outFileName);
+
+                sVerboseDump.logProcess(srcFile, ca.getArgv(), static_cast<int>(ca.getArgc()));
+                ProcessArgs procArgs(procPath, outFileName, ca);
+                procArgs.mStepId = stepId;
+                procArgs.mTraceCategory = (pm == PM_CovInstr) ? "instrument" : "compile";
+                procArgs.mCacheFilePath = cacheFilePath;
+                addTask(procArgs);
+                queued = true;
+                }
             if(incFileOlderIndex != BadIndex)
                 sVerboseDump.logOutputOld(incFiles[static_cast<size_t>(incFileOlderIndex)]);
             }
         }
+    return queued;
     }
 
-void ComponentBuilder::processJavaSourceFiles(eProcessModes pm,
+bool ComponentBuilder::processJavaSourceFiles(eProcessModes pm,
     OovStringRef compName, OovStringVec javaSources /*,
-    const OovStringSet &externPkgCompileArgs*/)
+    const OovStringSet &externPkgCompileArgs*/, size_t stepId)
     {
+    bool queued = false;
     OovString intDirName = ComponentTypesFile::getComponentDir(
         mIntermediatePath, compName);
 //    OovString outFileName = ComponentTypesFile::getComponentFileName(
@@ -609,7 +890,7 @@ void ComponentBuilder::processJavaSourceFiles(eProcessModes pm,
         FilePath outFileName(Project::makeTreeOutBaseFileName(srcFile,
             mSrcRootDir, mIntermediatePath), FP_File);
         outFileName.appendExtension(".class");
-        if(FileStat::isOutputOld(outFileName, srcFile, status))
+        if(mSourceFileTimes.isOutputOld(outFileName, srcFile, status))
             {
             OovString ownerComp = getComponentTypesFile().getComponentNameOwner(srcFile);
             mComponentFinder.setCompConfig(ownerComp);
@@ -697,11 +978,16 @@ void ComponentBuilder::processJavaSourceFiles(eProcessModes pm,
             OovString str = "classes for ";
             str += compName;
             sVerboseDump.logProcess(srcFileListFn, ca.getArgv(), static_cast<int>(ca.getArgc()));
-            addTask(ProcessArgs(procPath, str, ca));
+            ProcessArgs procArgs(procPath, str, ca);
+            procArgs.mStepId = stepId;
+            procArgs.mTraceCategory = "compile";
+            addTask(procArgs);
+            queued = true;
             }
 //        if(incFileOlderIndex != BadIndex)
 //            sVerboseDump.logOutputOld(incFiles[static_cast<size_t>(incFileOlderIndex)]);
         }
+    return queued;
     }
 
 OovString ComponentBuilder::getSymbolBasePath()
@@ -712,22 +998,23 @@ OovString ComponentBuilder::getSymbolBasePath()
     }
 
 void ComponentBuilder::makeLibSymbols(OovStringRef const clumpName,
-        OovStringVec const &files)
+        OovStringVec const &files, OovStringRef const objSymbolTool,
+        OovStringRef const symbolBasePath, ComponentTaskQueue &queue,
+        size_t numThreads)
     {
-    std::string objSymbolTool = mComponentFinder.getProjectBuildArgs().getObjSymbolPath();
-
     OovString str = "Make lib symbols: ";
     str += clumpName;
     str += "\n";
     sVerboseDump.logProgress(str);
 
     mObjSymbols.makeClumpSymbols(clumpName, files,
-            getSymbolBasePath(), objSymbolTool, *this);
+            symbolBasePath, objSymbolTool, queue, numThreads);
     }
 
-void ComponentBuilder::makeLib(OovStringRef const libPath,
-        OovStringVec const &objectFileNames)
+bool ComponentBuilder::makeLib(OovStringRef const libPath,
+        OovStringVec const &objectFileNames, size_t stepId)
     {
+    bool queued = false;
     OovString outFileName = makeLibFn(libPath);
     OovStatus status(true, SC_File);
     if(FileStat::isOutputOld(outFileName, objectFileNames, status))
@@ -744,8 +1031,14 @@ void ComponentBuilder::makeLib(OovStringRef const libPath,
             ca.addArg(objName);
             }
         sVerboseDump.logProcess(outFileName, ca.getArgv(), static_cast<int>(ca.getArgc()));
-        addTask(ProcessArgs(procPath, outFileName, ca));
+        ProcessArgs procArgs(procPath, outFileName, ca);
+        procArgs.mStepId = stepId;
+        procArgs.mIsProjectLib = true;
+        procArgs.mTraceCategory = "lib";
+        addTask(procArgs);
+        queued = true;
         }
+    return queued;
     }
 
 static void appendLibName(OovString libName, size_t linkOrderIndex,
@@ -764,20 +1057,16 @@ static void appendLibName(OovString libName, size_t linkOrderIndex,
 /// @param externPkgLinkArgs Link args from external packages
 //
 // getLinkArgs() contains -l from command line
-void ComponentBuilder::makeExe(OovStringRef const compName,
+bool ComponentBuilder::makeExe(OovStringRef const compName,
         OovStringVec const &sources,
         OovStringVec const &projectLibFilePaths,
         OovStringVec const &externLibsDirs,
         const IndexedStringVec &externPkgOrderedLibNames,
         const IndexedStringSet &externPkgLinkArgs,
-        bool shared)
+        bool shared, size_t stepId)
     {
-    OovString exeName = mComponentFinder.makeActualComponentName(compName);
-    OovString outFileName = mOutputPath + exeName;
-    if(shared)
-        outFileName += ".so";
-    else
-        outFileName = FilePathMakeExeFilename(outFileName);
+    bool queued = false;
+    OovString outFileName = makeExeFn(compName, shared);
 
     OovStringVec objects;
     for(const auto &src : sources)
@@ -868,13 +1157,19 @@ void ComponentBuilder::makeExe(OovStringRef const compName,
             ca.addArg(arg);
             }
         sVerboseDump.logProcess(outFileName, ca.getArgv(), ca.getArgc());
-        addTask(ProcessArgs(procPath, outFileName, ca));
+        ProcessArgs procArgs(procPath, outFileName, ca);
+        procArgs.mStepId = stepId;
+        procArgs.mTraceCategory = "link";
+        addTask(procArgs);
+        queued = true;
         }
+    return queued;
     }
 
-void ComponentBuilder::makeJar(OovStringRef const compName,
-    OovStringVec const &sources, bool prog)
+bool ComponentBuilder::makeJar(OovStringRef const compName,
+    OovStringVec const &sources, bool prog, size_t stepId)
     {
+    bool queued = false;
     OovString outFileName = makeOutputJarName(compName);
     OovString relCompDir = mComponentFinder.getRelCompDir(compName);
 
@@ -955,10 +1250,14 @@ void ComponentBuilder::makeJar(OovStringRef const compName,
         OovString intDirName = ComponentTypesFile::getComponentDir(
             mIntermediatePath, compName);
         procArgs.mWorkingDir = intDirName;
+        procArgs.mStepId = stepId;
+        procArgs.mTraceCategory = "link";
         addTask(procArgs);
+        queued = true;
         }
     if(status.needReport())
         {
         status.report(ET_Error, "Unable to check file times");
         }
+    return queued;
     }
@@ -12,6 +12,11 @@
 #include "ObjSymbols.h"
 #include "OovThreadedWaitQueue.h"
 #include "IncludeMap.h"
+#include "FileTimeCache.h"
+#include "CompileCache.h"
+#include "BuildDurations.h"
+#include <functional>
+#include <queue>
 
 
 class ComponentPkgDeps
@@ -41,6 +46,14 @@ class ProcessArgs
         OovProcessChildArgs mChildArgs;
         OovString mStdOutFn;  // zero length will not use the name
         OovString mLibFilePath; // Only used for lib symbol processing.
+        OovString mCacheFilePath; // Only used for storing compiled objects.
+        OovString mTraceCategory; // The type of process for the build trace.
+        /// If set, a worker calls this instead of running a process. The
+        /// output file is then only used to identify the task.
+        std::function<bool()> mTaskFunc;
+        bool mIsProjectLib = false; // Set when archiving a project library.
+        size_t mStepId = NoStepId;  // Only used when run from a BuildStepGraph.
+        static const size_t NoStepId = static_cast<size_t>(-1);
     };
 
 class TaskQueueListener
@@ -54,24 +67,116 @@ class TaskQueueListener
 class ComponentTaskQueue:public ThreadedWorkWaitQueue<ProcessArgs, ComponentTaskQueue>
     {
     public:
-        ComponentTaskQueue():
-            mListener(nullptr)
+        /// @param traceQueueName The name of the worker lanes in the build trace.
+        ComponentTaskQueue(OovStringRef const traceQueueName="build"):
+            mListener(nullptr), mStepGraph(nullptr), mDurations(nullptr),
+            mTraceQueueName(traceQueueName)
             {}
         // Set to nullptr to remove listener
         void setTaskListener(TaskQueueListener *listener)
             { mListener = listener; }
+        // Set to nullptr to remove the graph
+        void setStepGraph(class BuildStepGraph *graph)
+            { mStepGraph = graph; }
+        // Set to nullptr to stop recording the process durations.
+        void setDurations(BuildDurations *durations)
+            { mDurations = durations; }
 
         // Called by ThreadedWorkQueue
         bool processItem(ProcessArgs const &item);
 
         /// @param outFile - used only to make an output directory, and display error.
+        /// @param traceCategory - the type of process for the build trace.
         static bool runProcess(OovStringRef const procPath, OovStringRef const outFile,
             const OovProcessChildArgs &args, InProcMutex &mutex,
-            OovStringRef const stdOutFn=nullptr, OovStringRef const workingDir=nullptr);
+            OovStringRef const stdOutFn=nullptr, OovStringRef const workingDir=nullptr,
+            OovStringRef const traceCategory=nullptr);
 
         InProcMutex mListenerStdMutex;
     private:
         TaskQueueListener *mListener;
+        class BuildStepGraph *mStepGraph;
+        BuildDurations *mDurations;
+        OovString mTraceQueueName;
+    };
+
+/// Runs build steps in dependency order. A step is started as soon as all
+/// of the steps that it depends on are complete. This allows libraries and
+/// programs to be linked while other components are still compiling,
+/// instead of waiting for all compiles to finish.
+///
+/// When more than one step is ready, the step with the longest expected
+/// time to the end of the build is started first. This is the expected
+/// duration of the step plus the longest path through the steps that
+/// depend on it.
+///
+/// The start functions are all called from the thread that calls run(), so
+/// they can safely use the component finder and other builder data.
+class BuildStepGraph
+    {
+    public:
+        /// Called when all prerequisite steps are complete.
+        /// @param stepId The step id that must be put into ProcessArgs::mStepId
+        ///     if a task is added to the queue.
+        /// Returns true if a task was added to the queue, or false if the
+        /// step did not have anything to do.
+        typedef std::function<bool(size_t stepId)> StartFunc;
+
+        BuildStepGraph(ComponentTaskQueue &queue):
+            mQueue(queue), mNumComplete(0)
+            {}
+        /// Steps can only be added before run() is called.
+        /// @param startFunc The function to call when prerequisites are done.
+        /// @param prereqStepIds The steps that must complete before this step.
+        /// @param expectedMs The expected duration of the step.
+        /// Returns the step id.
+        size_t addStep(StartFunc const &startFunc,
+            std::vector<size_t> const &prereqStepIds = std::vector<size_t>(),
+            unsigned int expectedMs = 0);
+        /// Starts all steps and waits for them to complete.
+        void run();
+        /// Called by the worker threads when a queued task completes.
+        void stepComplete(size_t stepId);
+
+    private:
+        struct Step
+            {
+            StartFunc mStartFunc;
+            /// The number of prerequisites that are not complete.
+            size_t mNumWaiting;
+            std::vector<size_t> mDependentIds;
+            unsigned int mExpectedMs;
+            /// The expected duration of this step and the longest path
+            /// of dependent steps.
+            unsigned long long mPathMs;
+            };
+        struct ReadyStep
+            {
+            ReadyStep(unsigned long long pathMs, size_t stepId):
+                mPathMs(pathMs), mStepId(stepId)
+                {}
+            unsigned long long mPathMs;
+            size_t mStepId;
+            /// The longest path is at the top of the queue. Equal paths
+            /// are started in the order they were added.
+            bool operator<(ReadyStep const &step) const
+                {
+                return(mPathMs < step.mPathMs ||
+                    (mPathMs == step.mPathMs && mStepId > step.mStepId));
+                }
+            };
+        ComponentTaskQueue &mQueue;
+        std::vector<Step> mSteps;
+        std::priority_queue<ReadyStep> mReadySteps;
+        size_t mNumComplete;
+        std::mutex mStepMutex;
+        std::condition_variable mStepCompleteSignal;
+
+        /// The step mutex must be locked before calling this.
+        void stepCompleteLocked(size_t stepId);
+        /// Prerequisites are always added before the steps that depend on
+        /// them, so the paths are found by going through the steps backwards.
+        void computePaths();
     };
 
 // Builds components. This recursively compiles source files
@@ -84,6 +189,9 @@ class ComponentBuilder:public ComponentTaskQueue
             {}
         void build(eProcessModes mode,
             OovStringRef const incDepsFilePath, OovStringRef const buildDirClass);
+        /// An empty directory disables the compile cache.
+        void setCompileCacheDir(OovStringRef const cacheDir)
+            { mCompileCache.setCacheDir(cacheDir); }
 
     private:
         FilePath mSrcRootDir;
@@ -92,21 +200,29 @@ class ComponentBuilder:public ComponentTaskQueue
         ComponentFinder &mComponentFinder;
         ObjSymbols mObjSymbols;
         IncDirDependencyMapReader mIncDirMap;
+        /// The source and included files are not modified during the build.
+        FileTimeCache mSourceFileTimes;
         /// A map of all packages required to build each component.
         ComponentPkgDeps mComponentPkgDeps;
+        CompileCache mCompileCache;
+        /// The durations of previous processes are used to order the steps.
+        BuildDurations mBuildDurations;
 
         const ComponentTypesFile &getComponentTypesFile() const
             { return mComponentFinder.getComponentTypesFile(); }
         void buildComponents();
+        /// This is only used for coverage instrumentation. Building uses
+        /// buildComponents to run compiles in the step graph.
         void processSourceForComponents(eProcessModes pm);
         /// Saves a map of all packages required to build each component.
         /// Goes through all non-unknown components in the project and searches
         /// the include paths to see if any came from any of the packages. The
         /// map that is saved is mComponentPkgDeps.
         void generateDependencies();
-        void processCppSourceFile(eProcessModes pm, OovStringRef const srcFile,
-            const OovStringVec &incDirs, const OovStringVec &incFiles,
-            const OovStringSet &externPkgCompileArgs);
+        /// Returns true if a task was added to the queue.
+        bool processCppSourceFile(eProcessModes pm, OovStringRef const srcFile,
+            const OovStringSet &externPkgCompileArgs,
+            size_t stepId = ProcessArgs::NoStepId);
 
         /// This uses the javac program to create class files from java files.
         ///
@@ -125,18 +241,31 @@ class ComponentBuilder:public ComponentTaskQueue
         /// requires that the user must specify the classpath as an environment
         /// variable.  It would be nice to fix this in the future so the
         /// jar dependencies are resolved by adding -cp for supplier jars.
-        void processJavaSourceFiles(eProcessModes pm, OovStringRef compName,
-            OovStringVec javaSources /*, const OovStringSet &externPkgCompileArgs*/);
+        ///
+        /// Returns true if a task was added to the queue.
+        bool processJavaSourceFiles(eProcessModes pm, OovStringRef compName,
+            OovStringVec javaSources /*, const OovStringSet &externPkgCompileArgs*/,
+            size_t stepId = ProcessArgs::NoStepId);
 
-        void makeLib(OovStringRef const libName, const OovStringVec &objectFileNames);
-        void makeLibSymbols(OovStringRef const clumpName, OovStringVec const &files);
+        /// Returns true if a task was added to the queue.
+        bool makeLib(OovStringRef const libName, const OovStringVec &objectFileNames,
+            size_t stepId);
+        /// This does not use the component finder, so it can be called from
+        /// a worker thread.
+        /// @param objSymbolTool The tool for libraries that are not ELF files.
+        /// @param symbolBasePath The directory of the symbol files.
+        /// @param numThreads The number of threads used to read the libs.
+        void makeLibSymbols(OovStringRef const clumpName, OovStringVec const &files,
+            OovStringRef const objSymbolTool, OovStringRef const symbolBasePath,
+            ComponentTaskQueue &queue, size_t numThreads);
 
-        void makeExe(OovStringRef const compName, const OovStringVec &sources,
+        /// Returns true if a task was added to the queue.
+        bool makeExe(OovStringRef const compName, const OovStringVec &sources,
             const OovStringVec &projectLibsFilePaths,
             const OovStringVec &externLibDirs,
             const IndexedStringVec &externOrderedLibNames,
             const IndexedStringSet &externPkgLinkArgs,
-            bool shared);
+            bool shared, size_t stepId);
 
         /// This creates a jar if the output file is older than the input files.
         /// All library jars in the project are passed to the jar command.
@@ -147,8 +276,9 @@ class ComponentBuilder:public ComponentTaskQueue
         /// @param prog If true, then the jar libs in the project are used
         ///     while building the program jar. A Manifest.txt file is required
         ///     to be in the source directory if prog is true.
-        void makeJar(OovStringRef const compName, OovStringVec const &sources,
-            bool prog);
+        /// Returns true if a task was added to the queue.
+        bool makeJar(OovStringRef const compName, OovStringVec const &sources,
+            bool prog, size_t stepId);
 
 
         /// Returns the absolute path
@@ -164,6 +294,9 @@ class ComponentBuilder:public ComponentTaskQueue
             { return ComponentTypesFile::getComponentFileName(mOutputPath,
                 compName, "lib", "a"); }
 
+        /// Returns the absolute path of a program or shared library.
+        OovString makeExeFn(OovStringRef const compName, bool shared);
+
 
         OovString getSymbolBasePath();
         OovString getDiagFileName() const
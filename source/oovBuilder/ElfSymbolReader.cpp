@@ -0,0 +1,369 @@
+/*
+ * ElfSymbolReader.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *  \copyright 2026 DCBlaha.  Distributed under the GPL.
+ */
+
+#include "ElfSymbolReader.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <vector>
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include "File.h"
+#endif
+
+
+/// A read only view of a whole file.
+class MappedFile
+    {
+    public:
+        MappedFile():
+            mData(nullptr), mSize(0)
+            {}
+        ~MappedFile()
+            { close(); }
+        bool open(OovStringRef const filePath);
+        void close();
+        unsigned char const *getData() const
+            { return mData; }
+        size_t getSize() const
+            { return mSize; }
+
+    private:
+        unsigned char const *mData;
+        size_t mSize;
+#ifndef __linux__
+        std::vector<unsigned char> mBuffer;
+#endif
+    };
+
+#ifdef __linux__
+bool MappedFile::open(OovStringRef const filePath)
+    {
+    close();
+    int fd = ::open(filePath, O_RDONLY);
+    if(fd != -1)
+        {
+        struct stat fileStat;
+        if(fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+            {
+            void *data = mmap(nullptr, static_cast<size_t>(fileStat.st_size),
+                PROT_READ, MAP_PRIVATE, fd, 0);
+            if(data != MAP_FAILED)
+                {
+                mData = static_cast<unsigned char const *>(data);
+                mSize = static_cast<size_t>(fileStat.st_size);
+                }
+            }
+        ::close(fd);
+        }
+    return(mData != nullptr);
+    }
+
+void MappedFile::close()
+    {
+    if(mData)
+        {
+        munmap(const_cast<unsigned char *>(mData), mSize);
+        mData = nullptr;
+        mSize = 0;
+        }
+    }
+#else
+bool MappedFile::open(OovStringRef const filePath)
+    {
+    close();
+    File file;
+    OovStatus status = file.open(filePath, "rb");
+    int size = 0;
+    if(status.ok())
+        {
+        status = file.getFileSize(size);
+        }
+    if(status.ok() && size > 0)
+        {
+        mBuffer.resize(static_cast<size_t>(size));
+        status = file.read(reinterpret_cast<char*>(&mBuffer[0]), size);
+        if(status.ok())
+            {
+            mData = &mBuffer[0];
+            mSize = mBuffer.size();
+            }
+        }
+    if(status.needReport())
+        {
+        status.clearError();
+        }
+    return(mData != nullptr);
+    }
+
+void MappedFile::close()
+    {
+    mBuffer.clear();
+    mData = nullptr;
+    mSize = 0;
+    }
+#endif
+
+
+// These are the values from the ELF specification that are needed to
+// classify symbols.
+enum ElfValues
+    {
+    EV_Class32 = 1, EV_Class64 = 2,
+    EV_DataLittleEndian = 1, EV_DataBigEndian = 2,
+    EV_SectionSymTab = 2, EV_SectionNoBits = 8,
+    EV_FlagWrite = 0x1, EV_FlagExecInstr = 0x4,
+    EV_BindGlobal = 1,
+    EV_SymbolTypeGnuIFunc = 10,
+    EV_IndexUndef = 0, EV_IndexLoReserve = 0xff00
+    };
+
+/// Reads the symbol table of a single ELF object that is in memory.
+class ElfObject
+    {
+    public:
+        ElfObject(unsigned char const *data, size_t size):
+            mData(data), mSize(size), mIs64(false), mBigEndian(false)
+            {}
+        static bool isElf(unsigned char const *data, size_t size)
+            { return(size >= 16 && memcmp(data, "\x7F" "ELF", 4) == 0); }
+        bool readSymbols(ObjFileSymbols &symbols);
+
+    private:
+        struct Section
+            {
+            uint32_t mType;
+            uint64_t mFlags;
+            uint64_t mOffset;
+            uint64_t mSize;
+            uint32_t mLink;
+            uint64_t mEntrySize;
+            };
+        unsigned char const *mData;
+        size_t mSize;
+        bool mIs64;
+        bool mBigEndian;
+        std::vector<Section> mSections;
+
+        bool inRange(uint64_t offset, uint64_t size) const
+            { return(offset <= mSize && size <= mSize - offset); }
+        uint64_t get(uint64_t offset, int numBytes) const;
+        /// Returns 32 or 64 bit values depending on the ELF class.
+        uint64_t getWord(uint64_t offset) const
+            { return get(offset, mIs64 ? 8 : 4); }
+        bool readSections();
+        void readSymbolTable(Section const &symTab, ObjFileSymbols &symbols) const;
+    };
+
+uint64_t ElfObject::get(uint64_t offset, int numBytes) const
+    {
+    uint64_t val = 0;
+    for(int i=0; i<numBytes; i++)
+        {
+        int byteIndex = mBigEndian ? i : numBytes-1-i;
+        val = (val << 8) | mData[offset + static_cast<uint64_t>(byteIndex)];
+        }
+    return val;
+    }
+
+bool ElfObject::readSections()
+    {
+    bool success = false;
+    mIs64 = (mData[4] == EV_Class64);
+    mBigEndian = (mData[5] == EV_DataBigEndian);
+    size_t headerSize = mIs64 ? 64 : 52;
+    if((mData[4] == EV_Class32 || mData[4] == EV_Class64) &&
+        (mData[5] == EV_DataLittleEndian || mData[5] == EV_DataBigEndian) &&
+        inRange(0, headerSize))
+        {
+        uint64_t sectHeaderOffset = mIs64 ? get(0x28, 8) : get(0x20, 4);
+        uint64_t sectHeaderSize = get(mIs64 ? 0x3A : 0x2E, 2);
+        uint64_t numSections = get(mIs64 ? 0x3C : 0x30, 2);
+        uint64_t minSectHeaderSize = mIs64 ? 64 : 40;
+        if(sectHeaderOffset != 0 && sectHeaderSize >= minSectHeaderSize &&
+            inRange(sectHeaderOffset, sectHeaderSize))
+            {
+            // If there are many sections, the count is in the first section.
+            if(numSections == 0)
+                {
+                numSections = get(sectHeaderOffset + (mIs64 ? 32 : 20),
+                    mIs64 ? 8 : 4);
+                }
+            success = (numSections <= mSize / sectHeaderSize) &&
+                inRange(sectHeaderOffset, numSections * sectHeaderSize);
+            }
+        if(success)
+            {
+            mSections.resize(static_cast<size_t>(numSections));
+            for(size_t i=0; i<mSections.size(); i++)
+                {
+                uint64_t off = sectHeaderOffset + i * sectHeaderSize;
+                Section &sect = mSections[i];
+                sect.mType = static_cast<uint32_t>(get(off + 4, 4));
+                sect.mFlags = getWord(off + 8);
+                if(mIs64)
+                    {
+                    sect.mOffset = get(off + 24, 8);
+                    sect.mSize = get(off + 32, 8);
+                    sect.mLink = static_cast<uint32_t>(get(off + 40, 4));
+                    sect.mEntrySize = get(off + 56, 8);
+                    }
+                else
+                    {
+                    sect.mOffset = get(off + 16, 4);
+                    sect.mSize = get(off + 20, 4);
+                    sect.mLink = static_cast<uint32_t>(get(off + 24, 4));
+                    sect.mEntrySize = get(off + 36, 4);
+                    }
+                }
+            }
+        }
+    return success;
+    }
+
+void ElfObject::readSymbolTable(Section const &symTab, ObjFileSymbols &symbols) const
+    {
+    uint64_t symSize = mIs64 ? 24 : 16;
+    if(symTab.mLink < mSections.size() && symTab.mEntrySize >= symSize &&
+        inRange(symTab.mOffset, symTab.mSize))
+        {
+        Section const &strTab = mSections[symTab.mLink];
+        if(inRange(strTab.mOffset, strTab.mSize))
+            {
+            char const *strings = reinterpret_cast<char const *>(mData + strTab.mOffset);
+            uint64_t numSymbols = symTab.mSize / symTab.mEntrySize;
+            // The first symbol is always undefined and unnamed.
+            for(uint64_t symi=1; symi<numSymbols; symi++)
+                {
+                uint64_t off = symTab.mOffset + symi * symTab.mEntrySize;
+                uint64_t nameOffset = get(off, 4);
+                unsigned int info = mData[off + (mIs64 ? 4 : 12)];
+                uint64_t sectIndex = get(off + (mIs64 ? 6 : 14), 2);
+                if((info >> 4) == EV_BindGlobal &&
+                    (info & 0xF) != EV_SymbolTypeGnuIFunc &&
+                    nameOffset < strTab.mSize)
+                    {
+                    size_t maxLen = static_cast<size_t>(strTab.mSize - nameOffset);
+                    char const *name = strings + nameOffset;
+                    size_t nameLen = strnlen(name, maxLen);
+                    if(nameLen > 0 && nameLen < maxLen)
+                        {
+                        if(sectIndex == EV_IndexUndef)
+                            {
+                            symbols.mUndefinedSymbols.push_back(OovString(name, nameLen));
+                            }
+                        else if(sectIndex < EV_IndexLoReserve &&
+                            sectIndex < mSections.size())
+                            {
+                            // Only code and writable initialized data are
+                            // defined symbols. This matches nm T and D.
+                            Section const &sect = mSections[static_cast<size_t>(sectIndex)];
+                            if((sect.mFlags & EV_FlagExecInstr) ||
+                                ((sect.mFlags & EV_FlagWrite) &&
+                                sect.mType != EV_SectionNoBits))
+                                {
+                                symbols.mDefinedSymbols.push_back(OovString(name, nameLen));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+bool ElfObject::readSymbols(ObjFileSymbols &symbols)
+    {
+    bool success = isElf(mData, mSize) && readSections();
+    if(success)
+        {
+        for(auto const &sect : mSections)
+            {
+            if(sect.mType == EV_SectionSymTab)
+                {
+                readSymbolTable(sect, symbols);
+                }
+            }
+        }
+    return success;
+    }
+
+
+/// Reads all ELF objects in an ar archive. This handles the GNU and BSD
+/// formats for long member names.
+static bool readArchiveSymbols(unsigned char const *data, size_t size,
+        ObjFileSymbols &symbols)
+    {
+    const size_t MagicSize = 8;
+    const size_t HeaderSize = 60;
+    bool success = true;
+    size_t pos = MagicSize;
+    while(pos + HeaderSize <= size && success)
+        {
+        char const *header = reinterpret_cast<char const *>(data + pos);
+        char sizeStr[11];
+        memcpy(sizeStr, header + 48, 10);
+        sizeStr[10] = '\0';
+        size_t memberSize = static_cast<size_t>(strtoul(sizeStr, nullptr, 10));
+        size_t memberPos = pos + HeaderSize;
+        success = (memcmp(header + 58, "`\n", 2) == 0) &&
+            memberSize <= size - memberPos;
+        if(success)
+            {
+            unsigned char const *member = data + memberPos;
+            size_t objSize = memberSize;
+            // BSD archives put long names at the start of the member data.
+            if(memcmp(header, "#1/", 3) == 0)
+                {
+                size_t nameLen = static_cast<size_t>(atoi(header + 3));
+                if(nameLen <= objSize)
+                    {
+                    member += nameLen;
+                    objSize -= nameLen;
+                    }
+                }
+            // Skip the symbol index and long name tables. These names
+            // begin with a slash, while GNU member names begin with a
+            // slash only if they are long names that have a digit.
+            bool indexMember = (header[0] == '/' && !isdigit(header[1])) ||
+                memcmp(header, "__.SYMDEF", 9) == 0;
+            if(!indexMember)
+                {
+                ElfObject obj(member, objSize);
+                success = obj.readSymbols(symbols);
+                }
+            }
+        pos = memberPos + memberSize + (memberSize & 1);
+        }
+    return success;
+    }
+
+bool ElfSymbolReader::readSymbols(OovStringRef const filePath, ObjFileSymbols &symbols)
+    {
+    bool success = false;
+    MappedFile file;
+    if(file.open(filePath))
+        {
+        unsigned char const *data = file.getData();
+        size_t size = file.getSize();
+        if(size >= 8 && memcmp(data, "!<arch>\n", 8) == 0)
+            {
+            success = readArchiveSymbols(data, size, symbols);
+            }
+        else if(ElfObject::isElf(data, size))
+            {
+            ElfObject obj(data, size);
+            success = obj.readSymbols(symbols);
+            }
+        }
+    return success;
+    }
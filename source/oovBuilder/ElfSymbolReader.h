@@ -0,0 +1,43 @@
+/*
+ * ElfSymbolReader.h
+ *
+ *  Created on: Oct 16, 2026
+ *  \copyright 2026 DCBlaha.  Distributed under the GPL.
+ */
+
+#ifndef ELF_SYMBOL_READER_H_
+#define ELF_SYMBOL_READER_H_
+
+#include "OovString.h"
+
+/// The global symbols of a library or object file.
+class ObjFileSymbols
+    {
+    public:
+        /// Functions and initialized data (nm T and D).
+        OovStringVec mDefinedSymbols;
+        /// Referenced symbols that are not defined (nm U).
+        OovStringVec mUndefinedSymbols;
+
+        void clear()
+            {
+            mDefinedSymbols.clear();
+            mUndefinedSymbols.clear();
+            }
+    };
+
+/// Reads the global symbols from ELF object files, and from ar archives of
+/// ELF object files without running the object symbol tool. The file is
+/// memory mapped where possible.
+class ElfSymbolReader
+    {
+    public:
+        /// Returns false if the file cannot be read, or if it is not an ELF
+        /// object or an archive that only contains ELF objects. The symbols
+        /// are appended.
+        /// @param filePath The path of the library or object file.
+        /// @param symbols The returned symbols.
+        static bool readSymbols(OovStringRef const filePath, ObjFileSymbols &symbols);
+    };
+
+#endif
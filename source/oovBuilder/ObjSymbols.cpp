@@ -11,7 +11,11 @@
 #include <algorithm>
 #include "OovProcess.h"
 #include "ComponentBuilder.h"
+#include "ElfSymbolReader.h"
 #include "OovError.h"
+#include <string.h>
+#include <unordered_map>
+#include <unordered_set>
 
 class FileSymbol
     {
@@ -170,28 +174,79 @@ class FileIndices:public std::vector<size_t>
     };
 
 
+/// The symbols and dependencies of a library in a clump.
+class ClumpLibFile
+    {
+    public:
+        ClumpLibFile(OovStringRef const path=""):
+            mPath(path), mTime(0), mSize(0), mChanged(true), mReadFailed(false)
+            {}
+        bool sameKey(ClumpLibFile const &file) const
+            {
+            return(mPath == file.mPath && mTime == file.mTime &&
+                mSize == file.mSize);
+            }
+        OovString mPath;
+        /// The modification time and size are used with the path as the
+        /// cache key.
+        time_t mTime;
+        size_t mSize;
+        ObjFileSymbols mSymbols;
+        /// The file indices of the libraries that define the undefined symbols.
+        std::set<size_t> mSupplierIndices;
+        /// Set if the symbols were not in the cache, and must be read.
+        bool mChanged;
+        /// Set if the symbols could not be read. The library is then not
+        /// cached so that it is read again by the next build.
+        bool mReadFailed;
+    };
+
+/// The symbols and dependencies of the libraries are saved in a cache file
+/// so that only libraries that are changed must be read, and only the
+/// libraries that define or use their symbols must be resolved again.
 class ClumpSymbols
     {
     public:
+        ClumpSymbols():
+            mResolveAll(true)
+            {}
+        /// The files are indexed in this order. This also gets the cache key
+        /// of each file.
+        void setLibFiles(OovStringVec const &libFilePaths);
+        /// Use the symbols and dependencies of unchanged libraries from the
+        /// cache file of a previous build.
+        /// Returns true if no libraries were changed, added or removed.
+        bool readCache(OovStringRef const cacheFileName);
+        size_t getNumLibFiles() const
+            { return mLibFiles.size(); }
+        /// Each file has a separate symbol table, so the tables can be filled
+        /// from separate threads without locking.
+        ClumpLibFile &getLibFile(size_t fileIndex)
+            { return mLibFiles[fileIndex]; }
+        /// Returns FileSymbol::NoFileIndex if the file was not added.
+        size_t getFileIndex(OovStringRef const libFilePath) const;
         // Parse files for:
         // U referenced objects, but not defined
         // D global data object
         // T global function object
-        bool addSymbols(OovStringRef const libFilePath, OovStringRef const outFileName);
+        bool readRawSymbolFile(OovStringRef const outRawFileName, size_t fileIndex);
+        /// Find the suppliers of the changed libraries, and of the unchanged
+        /// libraries that use symbols that the changed libraries define or
+        /// used to define.
+        void resolveChangedLibs();
         void writeClumpFiles(OovStringRef const clumpName,
                 OovStringRef const outPath);
     private:
-        FileSymbols mDefinedSymbols;
-        FileSymbols mUndefinedSymbols;
-        FileDependencies mFileDependencies;
-        FileList mFileIndices;
-        FileIndices mOrderedDependencies;
-        std::mutex mDataMutex;
-        void resolveUndefinedSymbols();
-        bool readRawSymbolFile(OovStringRef const outRawFileName, size_t fileIndex);
+        std::vector<ClumpLibFile> mLibFiles;
+        /// The first library in the clump that defines each symbol.
+        std::unordered_map<std::string, size_t> mSymbolDefiners;
+        /// The symbols that changed libraries defined in the cache.
+        std::unordered_set<std::string> mOldChangedSymbols;
+        /// Set if libraries were added, removed or reordered.
+        bool mResolveAll;
+        void writeCache(OovStringRef const cacheFileName) const;
     };
 
-
 void FileIndices::removeValue(size_t val)
     {
     const auto &pos = findValue(val);
@@ -302,9 +357,236 @@ static void orderDependencies(size_t numFiles, const FileDependencies &fileDepen
         }
     }
 
+static OovString makeClumpFileName(OovStringRef const outPath,
+    OovStringRef const clumpName, OovStringRef const suffix)
+    {
+    FilePath fn(outPath, FP_Dir);
+    fn += "LibSym-";
+    fn += clumpName;
+    fn += suffix;
+    return fn;
+    }
+
+void ClumpSymbols::setLibFiles(OovStringVec const &libFilePaths)
+    {
+    mLibFiles.clear();
+    for(auto const &path : libFilePaths)
+        {
+        ClumpLibFile libFile(path);
+        OovStatus status = FileGetFileTimeSize(path, libFile.mTime, libFile.mSize);
+        if(status.needReport())
+            {
+            // A missing library will be reported by the symbol reader.
+            status.clearError();
+            }
+        mLibFiles.push_back(libFile);
+        }
+    }
+
+size_t ClumpSymbols::getFileIndex(OovStringRef const libFilePath) const
+    {
+    size_t fileIndex = FileSymbol::NoFileIndex;
+    for(size_t i=0; i<mLibFiles.size(); i++)
+        {
+        if(mLibFiles[i].mPath.compare(libFilePath) == 0)
+            {
+            fileIndex = i;
+            break;
+            }
+        }
+    return fileIndex;
+    }
+
+// The cache file has a group of lines for each library.
+//      l:time size path
+//      s:supplierIndex supplierIndex ...
+//      d:definedSymbol
+//      u:undefinedSymbol
+// @param keysOnly Set to only read the library lines.
+static void parseCache(char const *p, bool keysOnly,
+    std::vector<ClumpLibFile> &cachedFiles)
+    {
+    while(*p)
+        {
+        char const *endP = strchr(p, '\n');
+        if(!endP)
+            {
+            endP = p + strlen(p);
+            }
+        if(p[0] != '\0' && p[1] == ':')
+            {
+            char const *valP = p + 2;
+            if(p[0] == 'l')
+                {
+                char *nextP;
+                ClumpLibFile libFile;
+                libFile.mTime = static_cast<time_t>(strtoll(valP, &nextP, 10));
+                libFile.mSize = static_cast<size_t>(strtoull(nextP, &nextP, 10));
+                if(*nextP == ' ')
+                    {
+                    nextP++;
+                    }
+                libFile.mPath.assign(nextP, static_cast<size_t>(endP-nextP));
+                cachedFiles.push_back(libFile);
+                }
+            else if(!keysOnly && cachedFiles.size() > 0)
+                {
+                ClumpLibFile &libFile = cachedFiles.back();
+                if(p[0] == 's')
+                    {
+                    char *nextP = const_cast<char *>(valP);
+                    while(nextP < endP && isdigit(*nextP))
+                        {
+                        libFile.mSupplierIndices.insert(static_cast<size_t>(
+                            strtoul(nextP, &nextP, 10)));
+                        while(*nextP == ' ')
+                            nextP++;
+                        }
+                    }
+                else if(p[0] == 'd')
+                    {
+                    libFile.mSymbols.mDefinedSymbols.push_back(
+                        OovString(valP, static_cast<size_t>(endP-valP)));
+                    }
+                else if(p[0] == 'u')
+                    {
+                    libFile.mSymbols.mUndefinedSymbols.push_back(
+                        OovString(valP, static_cast<size_t>(endP-valP)));
+                    }
+                }
+            }
+        p = (*endP == '\n') ? endP + 1 : endP;
+        }
+    }
+
+bool ClumpSymbols::readCache(OovStringRef const cacheFileName)
+    {
+    std::vector<ClumpLibFile> cachedFiles;
+    std::string buf;
+    File file;
+    OovStatus status = file.open(cacheFileName, "rb");
+    int size = 0;
+    if(status.ok())
+        {
+        status = file.getFileSize(size);
+        }
+    if(status.ok() && size > 0)
+        {
+        buf.resize(static_cast<size_t>(size));
+        status = file.read(&buf[0], size);
+        }
+    if(status.needReport())
+        {
+        // The cache is optional, so everything will be read again.
+        status.clearError();
+        buf.clear();
+        }
+    // Most builds do not change any libraries, so first only the keys are
+    // checked.
+    parseCache(buf.c_str(), true, cachedFiles);
+    bool upToDate = (cachedFiles.size() == mLibFiles.size());
+    for(size_t i=0; i<cachedFiles.size() && upToDate; i++)
+        {
+        upToDate = mLibFiles[i].sameKey(cachedFiles[i]);
+        }
+    // If the libraries are up to date, the symbols are not needed unless
+    // the dependency file is missing. Then all symbols are read again.
+    if(!upToDate)
+        {
+        cachedFiles.clear();
+        parseCache(buf.c_str(), false, cachedFiles);
+
+        std::unordered_map<std::string, size_t> cachedIndices;
+        bool sameFiles = (cachedFiles.size() == mLibFiles.size());
+        for(size_t i=0; i<cachedFiles.size(); i++)
+            {
+            cachedIndices[cachedFiles[i].mPath] = i;
+            if(sameFiles && cachedFiles[i].mPath != mLibFiles[i].mPath)
+                {
+                sameFiles = false;
+                }
+            }
+        for(auto &libFile : mLibFiles)
+            {
+            auto const &iter = cachedIndices.find(libFile.mPath);
+            if(iter != cachedIndices.end())
+                {
+                ClumpLibFile &cachedFile = cachedFiles[(*iter).second];
+                if(libFile.sameKey(cachedFile))
+                    {
+                    libFile.mSymbols = std::move(cachedFile.mSymbols);
+                    libFile.mSupplierIndices = std::move(cachedFile.mSupplierIndices);
+                    libFile.mChanged = false;
+                    }
+                else
+                    {
+                    for(auto const &sym : cachedFile.mSymbols.mDefinedSymbols)
+                        {
+                        mOldChangedSymbols.insert(sym);
+                        }
+                    }
+                }
+            }
+        mResolveAll = !sameFiles;
+        }
+    return upToDate;
+    }
+
+void ClumpSymbols::writeCache(OovStringRef const cacheFileName) const
+    {
+    OovString str;
+    for(auto const &libFile : mLibFiles)
+        {
+        // The line is still written so that the supplier indices stay the
+        // same, but a time of -1 never matches the key of a library file.
+        str += "l:";
+        str += std::to_string(libFile.mReadFailed ? -1LL :
+            static_cast<long long>(libFile.mTime));
+        str += ' ';
+        str += std::to_string(static_cast<unsigned long long>(libFile.mSize));
+        str += ' ';
+        str += libFile.mPath;
+        str += "\ns:";
+        for(auto const &supIndex : libFile.mSupplierIndices)
+            {
+            str.appendInt(static_cast<int>(supIndex));
+            str += ' ';
+            }
+        str += '\n';
+        for(auto const &sym : libFile.mSymbols.mDefinedSymbols)
+            {
+            str += "d:";
+            str += sym;
+            str += '\n';
+            }
+        for(auto const &sym : libFile.mSymbols.mUndefinedSymbols)
+            {
+            str += "u:";
+            str += sym;
+            str += '\n';
+            }
+        }
+    File file;
+    OovStatus status = file.open(cacheFileName, "wb");
+    if(status.ok())
+        {
+        status = file.putString(str);
+        }
+    if(status.needReport())
+        {
+        OovString errStr = "Unable to write symbol cache file: ";
+        errStr += cacheFileName;
+        status.report(ET_Error, errStr);
+        }
+    }
+
+// The raw symbol file has the same format as the nm output. Each symbol line
+// is "[address] type name". Archive member names and blank lines do not have
+// a type.
 bool ClumpSymbols::readRawSymbolFile(OovStringRef const outRawFileName,
     size_t fileIndex)
     {
+    ObjFileSymbols &symbols = mLibFiles[fileIndex].mSymbols;
     File inFile;
     OovStatus status = inFile.open(outRawFileName, "r");
     if(status.ok())
@@ -312,26 +594,29 @@ bool ClumpSymbols::readRawSymbolFile(OovStringRef const outRawFileName,
         char buf[2000];
         while(inFile.getString(buf, sizeof(buf), status))
             {
-            char const *p = buf;
-            while(isspace(*p) || isxdigit(*p))
-                p++;
-            char symTypeChar = *p;
-
-            p++;
-            while(isspace(*p))
-                p++;
-            char const *endP = p;
-            while(!isspace(*endP))
-                endP++;
+            char const *endP = buf + strlen(buf);
+            while(endP > buf && isspace(endP[-1]))
+                endP--;
+            char const *p = endP;
+            while(p > buf && !isspace(p[-1]))
+                p--;
+            char const *typeP = p;
+            while(typeP > buf && isspace(typeP[-1]))
+                typeP--;
+            char symTypeChar = ' ';
+            if(typeP > buf && (typeP-1 == buf || isspace(typeP[-2])))
+                {
+                symTypeChar = typeP[-1];
+                }
             if(symTypeChar == 'D' || symTypeChar == 'T')
                 {
-                std::unique_lock<std::mutex> lock(mDataMutex);
-                mDefinedSymbols.add(p, static_cast<size_t>(endP-p), fileIndex);
+                symbols.mDefinedSymbols.push_back(OovString(p,
+                    static_cast<size_t>(endP-p)));
                 }
             else if(symTypeChar == 'U')
                 {
-                std::unique_lock<std::mutex> lock(mDataMutex);
-                mUndefinedSymbols.add(p, static_cast<size_t>(endP-p), fileIndex);
+                symbols.mUndefinedSymbols.push_back(OovString(p,
+                    static_cast<size_t>(endP-p)));
                 }
             }
         }
@@ -344,58 +629,98 @@ bool ClumpSymbols::readRawSymbolFile(OovStringRef const outRawFileName,
     return status.ok();
     }
 
-void ClumpSymbols::resolveUndefinedSymbols()
+void ClumpSymbols::resolveChangedLibs()
     {
-    for(const auto &sym : mDefinedSymbols)
+    mSymbolDefiners.clear();
+    for(size_t fileIndex=0; fileIndex<mLibFiles.size(); fileIndex++)
+        {
+        for(auto const &sym : mLibFiles[fileIndex].mSymbols.mDefinedSymbols)
+            {
+            // Only the first library that defines a symbol is used.
+            mSymbolDefiners.insert(std::make_pair(sym, fileIndex));
+            }
+        }
+    std::unordered_set<std::string> changedSymbols;
+    if(!mResolveAll)
         {
-        auto pos = mUndefinedSymbols.findName(sym.mSymbolName);
-        if(pos != mUndefinedSymbols.end())
+        changedSymbols = std::move(mOldChangedSymbols);
+        for(auto const &libFile : mLibFiles)
             {
-            // The file indices can be the same if one library has
-            // an object file where it is defined, and another object
-            // file where it is not defined.
-            if((*pos).mFileIndex != sym.mFileIndex)
+            if(libFile.mChanged)
                 {
-                mFileDependencies.addDependency((*pos).mFileIndex, sym.mFileIndex);
+                changedSymbols.insert(libFile.mSymbols.mDefinedSymbols.begin(),
+                    libFile.mSymbols.mDefinedSymbols.end());
                 }
-            mUndefinedSymbols.erase(pos);
             }
         }
-    }
-
-bool ClumpSymbols::addSymbols(OovStringRef const libFilePath, OovStringRef const outRawFileName)
-    {
+    for(size_t fileIndex=0; fileIndex<mLibFiles.size(); fileIndex++)
         {
-        std::unique_lock<std::mutex> lock(mDataMutex);
-        mFileIndices.push_back(libFilePath);
+        ClumpLibFile &libFile = mLibFiles[fileIndex];
+        bool resolve = mResolveAll || libFile.mChanged;
+        if(!resolve && changedSymbols.size() > 0)
+            {
+            for(auto const &sym : libFile.mSymbols.mUndefinedSymbols)
+                {
+                if(changedSymbols.find(sym) != changedSymbols.end())
+                    {
+                    resolve = true;
+                    break;
+                    }
+                }
+            }
+        if(resolve)
+            {
+            libFile.mSupplierIndices.clear();
+            for(auto const &sym : libFile.mSymbols.mUndefinedSymbols)
+                {
+                auto const &iter = mSymbolDefiners.find(sym);
+                // The file indices can be the same if one library has
+                // an object file where it is defined, and another object
+                // file where it is not defined.
+                if(iter != mSymbolDefiners.end() && (*iter).second != fileIndex)
+                    {
+                    libFile.mSupplierIndices.insert((*iter).second);
+                    }
+                }
+            }
         }
-    return readRawSymbolFile(outRawFileName, mFileIndices.size()-1);
     }
 
 void ClumpSymbols::writeClumpFiles(OovStringRef const clumpName,
         OovStringRef const outPath)
     {
-    resolveUndefinedSymbols();
-    orderDependencies(mFileIndices.size(), mFileDependencies, mOrderedDependencies);
-
-    OovString defSymFileName = outPath;
-    OovString undefSymFileName = defSymFileName;
-    OovString depSymFileName = defSymFileName;
-    undefSymFileName += "LibSym-";
-    undefSymFileName += clumpName;
-    undefSymFileName += "-Undef.txt";
-
-    defSymFileName += "LibSym-";
-    defSymFileName += clumpName;
-    defSymFileName += "-Def.txt";
-
-    depSymFileName += "LibSym-";
-    depSymFileName += clumpName;
-    depSymFileName += "-Dep.txt";
-    mDefinedSymbols.writeSymbols(defSymFileName);
-    mUndefinedSymbols.writeSymbols(undefSymFileName);
-    writeDepFileInfo(depSymFileName, mFileIndices, mFileDependencies,
-            mOrderedDependencies);
+    FileList fileNames;
+    FileDependencies fileDependencies;
+    FileSymbols definedSymbols;
+    FileSymbols undefinedSymbols;
+    for(size_t fileIndex=0; fileIndex<mLibFiles.size(); fileIndex++)
+        {
+        ClumpLibFile const &libFile = mLibFiles[fileIndex];
+        fileNames.push_back(libFile.mPath);
+        for(auto const &supIndex : libFile.mSupplierIndices)
+            {
+            fileDependencies.addDependency(fileIndex, supIndex);
+            }
+        for(auto const &sym : libFile.mSymbols.mUndefinedSymbols)
+            {
+            if(mSymbolDefiners.find(sym) == mSymbolDefiners.end())
+                {
+                undefinedSymbols.add(sym, sym.length(), fileIndex);
+                }
+            }
+        }
+    for(auto const &definer : mSymbolDefiners)
+        {
+        definedSymbols.add(definer.first, definer.first.length(), definer.second);
+        }
+    FileIndices orderedDependencies;
+    orderDependencies(mLibFiles.size(), fileDependencies, orderedDependencies);
+
+    definedSymbols.writeSymbols(makeClumpFileName(outPath, clumpName, "-Def.txt"));
+    undefinedSymbols.writeSymbols(makeClumpFileName(outPath, clumpName, "-Undef.txt"));
+    writeDepFileInfo(makeClumpFileName(outPath, clumpName, "-Dep.txt"),
+        fileNames, fileDependencies, orderedDependencies);
+    writeCache(makeClumpFileName(outPath, clumpName, "-Cache.txt"));
     }
 
 class ObjTaskListener:public TaskQueueListener
@@ -415,130 +740,156 @@ void ObjTaskListener::extraProcessing(bool success, OovStringRef const /*outFile
     {
     if(success)
         {
-        mClumpSymbols.addSymbols(item.mLibFilePath, stdOutFn);
+        size_t fileIndex = mClumpSymbols.getFileIndex(item.mLibFilePath);
+        if(fileIndex != FileSymbol::NoFileIndex)
+            {
+            // The exit code of the tool is not always available, so no
+            // symbols is also treated as a failure.
+            ClumpLibFile &libFile = mClumpSymbols.getLibFile(fileIndex);
+            if(mClumpSymbols.readRawSymbolFile(stdOutFn, fileIndex) &&
+                (libFile.mSymbols.mDefinedSymbols.size() > 0 ||
+                libFile.mSymbols.mUndefinedSymbols.size() > 0))
+                {
+                libFile.mReadFailed = false;
+                }
+            }
         }
     }
 
-bool ObjSymbols::makeObjectSymbols(OovStringVec const &libFiles,
-        OovStringRef const outSymPath, OovStringRef const objSymbolTool,
-        ComponentTaskQueue &queue, ClumpSymbols &clumpSymbols)
+struct LibSymbolReadItem
     {
-    struct LibFileNames
-        {
-        LibFileNames(OovString const &libFileName,
-                OovString const &libSymFileName,
-                OovString const &libFilePath, bool genSymbolFile):
-            mLibFileName(libFileName), mLibFilePath(libFilePath),
-            mLibSymFileName(libSymFileName), mGenSymbolFile(genSymbolFile)
+    LibSymbolReadItem(size_t fileIndex=0, OovStringRef const libFilePath="",
+            OovStringRef const libSymFileName=""):
+        mFileIndex(fileIndex), mLibFilePath(libFilePath),
+        mLibSymFileName(libSymFileName)
+        {}
+    size_t mFileIndex;
+    OovString mLibFilePath;
+    OovString mLibSymFileName;
+    };
+
+/// Reads the library symbols without running the object symbol tool. Each
+/// library is read into its own symbol table in the clump.
+class LibSymbolReadQueue:public ThreadedWorkWaitQueue<LibSymbolReadItem,
+    LibSymbolReadQueue>
+    {
+    public:
+        LibSymbolReadQueue(ClumpSymbols &clumpSymbols):
+            mClumpSymbols(clumpSymbols)
             {}
-        OovString mLibFileName;
-        OovString mLibFilePath;
-        OovString mLibSymFileName;
-        bool mGenSymbolFile;
-        };
-    bool generatedSymbols = false;
-    std::vector<LibFileNames> libFileNames;
-    OovStatus status(true, SC_File);
-    for(const auto &libFilePath : libFiles)
+        // Called by ThreadedWorkQueue
+        void processItem(LibSymbolReadItem const &item);
+        /// These are the files that are not ELF files. This must only be
+        /// called after waitForCompletion.
+        std::vector<LibSymbolReadItem> const &getUnreadItems() const
+            { return mUnreadItems; }
+
+    private:
+        ClumpSymbols &mClumpSymbols;
+        std::mutex mUnreadMutex;
+        std::vector<LibSymbolReadItem> mUnreadItems;
+    };
+
+void LibSymbolReadQueue::processItem(LibSymbolReadItem const &item)
+    {
+    ClumpLibFile &libFile = mClumpSymbols.getLibFile(item.mFileIndex);
+    ObjFileSymbols &symbols = libFile.mSymbols;
+    if(!ElfSymbolReader::readSymbols(item.mLibFilePath, symbols))
         {
-        FilePath libSymName(libFilePath, FP_File);
-        libSymName.discardDirectory();
-        libSymName.discardExtension();
-        OovString libSymPath = outSymPath;
-        FilePathEnsureLastPathSep(libSymPath);
-        status = FileEnsurePathExists(libSymPath);
-        if(status.ok())
-            {
-            OovString outSymRawFileName = libSymPath + libSymName + ".txt";
-/*
-            std::string libName = libFilePath;
-            size_t libNamePos = rfindPathSep(libName);
-            if(libNamePos != std::string::npos)
-                libNamePos++;
-            else
-                libNamePos = 0;
-            libName.insert(libNamePos, "lib");
-            std::string libFileName = // std::string(outLibPath) +
-                libName + ".a";
-*/
-            if(FileStat::isOutputOld(outSymRawFileName, libFilePath, status))
-                {
-                libFileNames.push_back(LibFileNames(libFilePath, outSymRawFileName,
-                        libFilePath, true));
-                generatedSymbols = true;
-                }
-            else
-                {
-                libFileNames.push_back(LibFileNames(libFilePath, outSymRawFileName,
-                        libFilePath, false));
-                }
-            }
-        if(!status.ok())
+        symbols.clear();
+        // This is cleared if the object symbol tool can read the symbols.
+        libFile.mReadFailed = true;
+        std::unique_lock<std::mutex> lock(mUnreadMutex);
+        mUnreadItems.push_back(item);
+        }
+    }
+
+bool ObjSymbols::makeObjectSymbols(OovStringRef const outSymPath,
+        OovStringRef const objSymbolTool, ComponentTaskQueue &queue,
+        size_t numThreads, ClumpSymbols &clumpSymbols)
+    {
+    bool readSymbols = false;
+    LibSymbolReadQueue readQueue(clumpSymbols);
+    readQueue.setupQueue(numThreads);
+    for(size_t fileIndex=0; fileIndex<clumpSymbols.getNumLibFiles(); fileIndex++)
+        {
+        ClumpLibFile const &libFile = clumpSymbols.getLibFile(fileIndex);
+        if(libFile.mChanged)
             {
-            break;
+            FilePath libSymName(libFile.mPath, FP_File);
+            libSymName.discardDirectory();
+            libSymName.discardExtension();
+            FilePath libSymPath(outSymPath, FP_Dir);
+            readQueue.addTask(LibSymbolReadItem(fileIndex, libFile.mPath,
+                libSymPath + libSymName + ".txt"));
+            readSymbols = true;
             }
         }
+    readQueue.waitForCompletion();
 
-    if(generatedSymbols)
+    // Files that are not ELF files are read using the object symbol tool.
+    std::vector<LibSymbolReadItem> const &unreadItems = readQueue.getUnreadItems();
+    if(unreadItems.size() > 0)
         {
-#define MULTI_THREAD 1
-#if(MULTI_THREAD)
         ObjTaskListener listener(clumpSymbols);
         queue.setTaskListener(&listener);
-        queue.setupQueue(queue.getNumHardwareThreads());
-#endif
-        for(auto const &libFn : libFileNames)
+        queue.setupQueue(numThreads);
+        for(auto const &item : unreadItems)
             {
-            if(libFn.mGenSymbolFile)
-                {
-                OovProcessChildArgs ca;
-                ca.addArg(objSymbolTool);
-                std::string quotedLibFilePath = libFn.mLibFilePath;
-                FilePathQuoteCommandLinePath(quotedLibFilePath);
-                ca.addArg(quotedLibFilePath);
-
-                ProcessArgs procArgs(objSymbolTool, libFn.mLibSymFileName, ca,
-                        libFn.mLibSymFileName.getStr());
-                procArgs.mLibFilePath = libFn.mLibFilePath;
-#if(MULTI_THREAD)
-                queue.addTask(procArgs);
-#else
-                success = ComponentBuilder::runProcess(objSymbolTool,
-                    outRawFileName, ca, mListenerStdMutex, outRawFileName);
-                if(success)
-                    clumpSymbols.addSymbols(libFilePath, outRawFileName);
-#endif
-                }
-            else
-                {
-                clumpSymbols.addSymbols(libFn.mLibFilePath,
-                        libFn.mLibSymFileName);
-                }
+            OovProcessChildArgs ca;
+            ca.addArg(objSymbolTool);
+            std::string quotedLibFilePath = item.mLibFilePath;
+            FilePathQuoteCommandLinePath(quotedLibFilePath);
+            ca.addArg(quotedLibFilePath);
+
+            ProcessArgs procArgs(objSymbolTool, item.mLibSymFileName, ca,
+                    item.mLibSymFileName.getStr());
+            procArgs.mLibFilePath = item.mLibFilePath;
+            procArgs.mTraceCategory = "symbols";
+            queue.addTask(procArgs);
             }
-#if(MULTI_THREAD)
         queue.waitForCompletion();
         queue.setTaskListener(nullptr);
-#endif
         }
-    return generatedSymbols;
+    return readSymbols;
     }
 
 bool ObjSymbols::makeClumpSymbols(OovStringRef const clumpName,
         OovStringVec const &libFiles, OovStringRef const outSymPath,
-        OovStringRef const objSymbolTool, ComponentTaskQueue &queue)
+        OovStringRef const objSymbolTool, ComponentTaskQueue &queue,
+        size_t numThreads)
     {
     bool success = true;
     ClumpSymbols clumpSymbols;
-//    std::string defSymFileName = outSymPath;
-//    ensureLastPathSep(defSymFileName);
-
-//    defSymFileName += "LibSym-";
-//    defSymFileName += clumpName;
-//    defSymFileName += "-Def.txt";
-    if(//!fileExists(defSymFileName) ||
-            makeObjectSymbols(libFiles, outSymPath, objSymbolTool, queue, clumpSymbols))
+    clumpSymbols.setLibFiles(libFiles);
+    bool upToDate = clumpSymbols.readCache(makeClumpFileName(outSymPath,
+        clumpName, "-Cache.txt"));
+    OovStatus status(true, SC_File);
+    // The dependency file is used to get the library order.
+    if(upToDate)
+        {
+        upToDate = FileIsFileOnDisk(makeClumpFileName(outSymPath, clumpName,
+            "-Dep.txt"), status);
+        if(status.needReport())
+            {
+            status.clearError();
+            }
+        }
+    if(!upToDate)
         {
-        clumpSymbols.writeClumpFiles(clumpName, outSymPath);
+        status = FileEnsurePathExists(outSymPath);
+        if(status.ok())
+            {
+            makeObjectSymbols(outSymPath, objSymbolTool, queue, numThreads,
+                clumpSymbols);
+            clumpSymbols.resolveChangedLibs();
+            clumpSymbols.writeClumpFiles(clumpName, outSymPath);
+            }
+        else
+            {
+            status.report(ET_Error, "Unable to create symbol directory");
+            success = false;
+            }
         }
     return success;
     }
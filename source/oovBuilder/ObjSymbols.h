@@ -19,12 +19,16 @@ class ObjSymbols
         ///     files. Normally it relates to a library path that may contain
         ///     many libraries.
         /// @param libFileNames List of all library file names in a clump.
+        ///     The symbols of libraries that have not changed since the
+        ///     last build are read from a cache file.
         /// @param outSymPath Location of where to put symbol information.
         /// @param objSymbolTool The executable name.
         /// @param queue The queue of tasks/processes for processing the libs.
+        /// @param numThreads The number of threads used to read the libs.
         bool makeClumpSymbols(OovStringRef const clumpName,
                 OovStringVec const &libFileNames, OovStringRef const outSymPath,
-                OovStringRef const objSymbolTool, class ComponentTaskQueue &queue);
+                OovStringRef const objSymbolTool, class ComponentTaskQueue &queue,
+                size_t numThreads);
 
         // From the clump, append the ordered libraries with their directories.
         static void appendOrderedLibs(OovStringRef const clumpName,
@@ -36,9 +40,11 @@ class ObjSymbols
 
     private:
         InProcMutex mListenerStdMutex;
-        bool makeObjectSymbols(OovStringVec const &libFiles,
-                OovStringRef const outSymPath, OovStringRef const objSymbolTool,
-                ComponentTaskQueue &queue, class ClumpSymbols &clumpSymbols);
+        /// Reads the symbols of the libraries that were not in the cache.
+        /// Returns true if any symbols were read.
+        bool makeObjectSymbols(OovStringRef const outSymPath,
+                OovStringRef const objSymbolTool, ComponentTaskQueue &queue,
+                size_t numThreads, class ClumpSymbols &clumpSymbols);
     };
 
 
@@ -27,6 +27,7 @@
 #include "Packages.h"
 #include "Coverage.h"
 #include "OovError.h"
+#include "BuildTrace.h"
 #include <stdio.h>
 
 
@@ -34,7 +35,8 @@ class OovBuilder
     {
     public:
         void process(eProcessModes processMode, OovStringRef oovProjDir,
-            OovStringRef buildConfigName, bool verbose);
+            OovStringRef buildConfigName, bool verbose, bool compileCache,
+            bool trace);
 
     private:
         ComponentFinder mCompFinder;
@@ -42,16 +44,17 @@ class OovBuilder
         void analyze(BuildConfigWriter &cfg, eProcessModes procMode,
             OovStringRef const buildConfigName, OovStringRef const srcRootDir);
         void build(eProcessModes processMode, OovStringRef oovProjDir,
-            OovStringRef buildConfigName, bool verbose);
+            OovStringRef buildConfigName, bool verbose, bool compileCache,
+            bool trace);
         void clean(eProcessModes pm, OovStringRef oovProjDir);
         bool readProject(OovStringRef oovProjDir, OovStringRef buildMode,
-            OovStringRef buildConfigName, bool verbose);
+            OovStringRef buildConfigName, bool verbose, bool trace);
         ComponentFinder &getComponentFinder()
             { return mCompFinder; }
     };
 
 void OovBuilder::process(eProcessModes processMode, OovStringRef oovProjDir,
-    OovStringRef buildConfigName, bool verbose)
+    OovStringRef buildConfigName, bool verbose, bool compileCache, bool trace)
     {
     if(processMode & PM_CleanMask)
         {
@@ -59,7 +62,8 @@ void OovBuilder::process(eProcessModes processMode, OovStringRef oovProjDir,
         }
     else
         {
-        build(processMode, oovProjDir, buildConfigName, verbose);
+        build(processMode, oovProjDir, buildConfigName, verbose, compileCache,
+            trace);
         }
     }
 
@@ -157,7 +161,8 @@ void OovBuilder::clean(eProcessModes pm, OovStringRef oovProjDir)
     }
 
 void OovBuilder::build(eProcessModes processMode, OovStringRef oovProjDir,
-        OovStringRef buildConfigName, bool verbose)
+        OovStringRef buildConfigName, bool verbose, bool compileCache,
+        bool trace)
     {
     bool success = true;
     Project::setProjectDirectory(oovProjDir);
@@ -178,7 +183,7 @@ void OovBuilder::build(eProcessModes processMode, OovStringRef oovProjDir,
             {
             // This must be after creating the coverage project.
             success = readProject(Project::getProjectDirectory(), buildMode,
-                buildConfigName, verbose);
+                buildConfigName, verbose, trace);
             }
         }
     if(success)
@@ -208,16 +213,22 @@ void OovBuilder::build(eProcessModes processMode, OovStringRef oovProjDir,
                     {
                     std::string incDepsPath = cfg.getIncDepsFilePath();
                     ComponentBuilder compBuilder(getComponentFinder());
+                    if(compileCache ||
+                            mCompFinder.getProjectBuildArgs().getCompileCache())
+                        {
+                        compBuilder.setCompileCacheDir(Project::getCompileCacheDir());
+                        }
                     compBuilder.build(processMode, incDepsPath, buildConfigName);
                     }
                     break;
                 }
             }
         }
+    sBuildTrace.close();
     }
 
 bool OovBuilder::readProject(OovStringRef oovProjDir, OovStringRef buildMode,
-    OovStringRef buildConfigName, bool verbose)
+    OovStringRef buildConfigName, bool verbose, bool trace)
     {
     bool success = mCompFinder.readProject(oovProjDir, buildMode, buildConfigName);
     if(success)
@@ -227,6 +238,16 @@ bool OovBuilder::readProject(OovStringRef oovProjDir, OovStringRef buildMode,
             {
             sVerboseDump.open(oovProjDir);
             }
+        if(mCompFinder.getProjectBuildArgs().getBuildTrace() || trace)
+            {
+            OovStatus status = sBuildTrace.open(Project::getBuildTraceFilePath());
+            if(status.needReport())
+                {
+                OovString err = "Unable to open trace file ";
+                err += Project::getBuildTraceFilePath();
+                status.report(ET_Error, err);
+                }
+            }
         }
     else
         {
@@ -283,6 +304,7 @@ void OovBuilder::analyze(BuildConfigWriter &cfg,
         mCompFinder.getProjectBuildArgs().getAllCrcCompileArgs(),
         mCompFinder.getProjectBuildArgs().getAllCrcLinkArgs());
 
+    sBuildTrace.beginPhase("scan");
     if(status.ok() && (cfg.isConfigDifferent(buildConfigName, BuildConfig::CT_ExtPathArgsCrc) ||
             !havePackages))
         {
@@ -317,6 +339,7 @@ void OovBuilder::analyze(BuildConfigWriter &cfg,
         status = mCompFinder.scanProject();
         fflush(stdout);
         }
+    sBuildTrace.endPhase("scan");
     if(status.ok())
         {
         srcFileParser sfp(mCompFinder);
@@ -393,7 +416,9 @@ void OovBuilder::analyze(BuildConfigWriter &cfg,
         if(status.ok())
             {
             mCompFinder.saveProject(analysisPath);
+            sBuildTrace.beginPhase("analyze");
             sfp.analyzeSrcFiles(srcRootDir, analysisPath);
+            sBuildTrace.endPhase("analyze");
             }
         if(status.needReport())
             {
@@ -412,6 +437,8 @@ int main(int argc, char const * const argv[])
     eProcessModes processMode = PM_Analyze;
     OovError::setComponent(EC_OovBuilder);
     bool verbose = false;
+    bool compileCache = false;
+    bool trace = false;
     bool success = (argc >= 2);
     if(success)
         {
@@ -474,6 +501,14 @@ int main(int argc, char const * const argv[])
                 {
                 verbose = true;
                 }
+            else if(testArg.compare("-bc") == 0)
+                {
+                compileCache = true;
+                }
+            else if(testArg.compare("-bt") == 0)
+                {
+                trace = true;
+                }
             }
         }
     else
@@ -487,11 +522,14 @@ int main(int argc, char const * const argv[])
             fprintf(stderr, "    -mode-<analyze|build|clean-[abc]|cov-instr|cov-build|cov-stats>\n");
             fprintf(stderr, "               cov means coverage, [abc] means analyze, build, coverage \n");
             fprintf(stderr, "    -bv         builder verbose - OovBuilder.txt file\n");
+            fprintf(stderr, "    -bc         builder compile cache - reuse object files\n");
+            fprintf(stderr, "    -bt         builder trace - oovaide-trace.json file\n");
         }
 
     if(success)
         {
-        builder.process(processMode, oovProjDir, buildConfigName, verbose);
+        builder.process(processMode, oovProjDir, buildConfigName, verbose,
+            compileCache, trace);
         }
     return 0;
     }
@@ -8,26 +8,219 @@
 #include "FilePath.h"
 #include "OovProcess.h"
 #include "ComponentFinder.h"
+#include "IncludeMap.h"
+#include "BuildTrace.h"
 #include <stdio.h>
+#include <string.h>
+#include <limits.h>
 #include <algorithm>
+#include <chrono>
+
+static OovString getCppParserPath()
+    {
+    FilePath path(Project::getBinDirectory(), FP_Dir);
+    path.appendFile("oovCppParser");
+    return FilePathMakeExeFilename(path);
+    }
 
 bool srcFileParser::analyzeSrcFiles(OovStringRef const srcRootDir,
         OovStringRef const analysisDir)
     {
     mSrcRootDir = srcRootDir;
     mAnalysisDir = analysisDir;
+    mCppParserPath = getCppParserPath();
 
 #define MULTIPLE_THREADS 1
 #if(MULTIPLE_THREADS)
-    // This requires that the oovaide-incdeps file can be updated by multiple processes.
+    // Each parser writes a separate include dependency fragment file.
     setupQueue(getNumHardwareThreads());
 #else
     setupQueue(1);
 #endif
     mExcludeDirs = mComponentFinder.getProjectBuildArgs().getProjectExcludeDirs();
-    OovStatus status = recurseDirs(srcRootDir);
+    FilePath incDepsFilePath(analysisDir, FP_Dir);
+    incDepsFilePath.appendFile(Project::getAnalysisIncDepsFilename());
+    OovStatus status = mIncDirMap.read(incDepsFilePath);
+    if(status.needReport())
+        {
+        status.reported();      // Inc dir map is optional.
+        }
+    std::set<OovString> allFiles = mIncDirMap.getAllFiles();
+    mSourceFileTimes.readFileTimes(OovStringVec(allFiles.begin(), allFiles.end()));
+    mAnalysisDurations.read(Project::getAnalysisDurationsFilePath());
+    status = recurseDirs(srcRootDir);
+    std::stable_sort(mPendingTasks.begin(), mPendingTasks.end(),
+        [](std::pair<unsigned int, CppChildArgs> const &task1,
+        std::pair<unsigned int, CppChildArgs> const &task2)
+        { return(task1.first > task2.first); });
+    for(auto const &task : mPendingTasks)
+        {
+        addTask(task.second);
+        }
+    mPendingTasks.clear();
     waitForCompletion();
-    return status.ok();
+    OovStatus durStatus = mAnalysisDurations.write();
+    if(durStatus.needReport())
+        {
+        durStatus.report(ET_Error, "Unable to write analysis durations");
+        }
+    // Stop the parser processes.
+    mCppParserWorkers.clear();
+    IncDirDependencyMapMerger incDepsMerger;
+    OovStatus mergeStatus = incDepsMerger.merge(analysisDir);
+    if(mergeStatus.needReport())
+        {
+        mergeStatus.reported();
+        }
+    return status.ok() && mergeStatus.ok();
+    }
+
+
+/// Receives the output of the parser server, and finds the result of
+/// each request. The request is complete when both the result on stdout
+/// and the end of the error output on stderr are received.
+class CppParserWorkerListener:public OovProcessListener,
+    public OovTaskContinueListener
+    {
+    public:
+        CppParserWorkerListener(OovProcessListener &listener):
+            mListener(listener), mGotResult(false), mGotErrEnd(false),
+            mExitCode(-1)
+            {}
+        virtual void onStdOut(OovStringRef const out, size_t len) override;
+        virtual void onStdErr(OovStringRef const out, size_t len) override;
+        virtual bool continueProcessingItem() const override
+            { return !(mGotResult && mGotErrEnd); }
+        int getExitCode() const
+            { return mExitCode; }
+
+    private:
+        OovProcessListener &mListener;
+        OovString mLine;
+        OovString mErrLine;
+        bool mGotResult;
+        bool mGotErrEnd;
+        int mExitCode;
+    };
+
+void CppParserWorkerListener::onStdErr(OovStringRef const out, size_t len)
+    {
+    mErrLine.append(out.getStr(), len);
+    size_t startPos = 0;
+    size_t endPos;
+    while((endPos = mErrLine.find('\n', startPos)) != std::string::npos)
+        {
+        OovString line = mErrLine.substr(startPos, endPos-startPos);
+        if(line.compare(CppParserServerErrEnd) == 0)
+            {
+            mGotErrEnd = true;
+            }
+        else if(line.length() > 0)
+            {
+            line += '\n';
+            mListener.onStdErr(line, line.length());
+            }
+        startPos = endPos+1;
+        }
+    mErrLine.erase(0, startPos);
+    }
+
+void CppParserWorkerListener::onStdOut(OovStringRef const out, size_t len)
+    {
+    mLine.append(out.getStr(), len);
+    size_t startPos = 0;
+    size_t endPos;
+    while((endPos = mLine.find('\n', startPos)) != std::string::npos)
+        {
+        OovString line = mLine.substr(startPos, endPos-startPos);
+        size_t resultLen = strlen(CppParserServerResult);
+        if(line.compare(0, resultLen, CppParserServerResult) == 0)
+            {
+            OovString exitStr = line.substr(resultLen);
+            if(!exitStr.getInt(INT_MIN, INT_MAX, mExitCode))
+                {
+                mExitCode = -1;
+                }
+            mGotResult = true;
+            }
+        else if(line.length() > 0)
+            {
+            line += '\n';
+            mListener.onStdOut(line, line.length());
+            }
+        startPos = endPos+1;
+        }
+    mLine.erase(0, startPos);
+    }
+
+CppParserWorker::~CppParserWorker()
+    {
+    if(mRunning)
+        {
+        // A request with no arguments stops the server.
+        mPipeProc.childProcessSend("0\n");
+        OovProcessStdListener listener;
+        int exitCode;
+        mPipeProc.childProcessListen(listener, exitCode);
+        }
+    }
+
+bool CppParserWorker::parse(CppChildArgs const &item,
+    OovProcessListener &listener, int &exitCode)
+    {
+    exitCode = -1;
+    if(!mRunning)
+        {
+        char const *argv[] = { item.getArgv()[0], CppParserServerArg, nullptr };
+        mRunning = mPipeProc.createProcess(argv[0], argv, false);
+        }
+    bool success = mRunning;
+    if(success)
+        {
+        OovString request;
+        request.appendInt(static_cast<int>(item.getArgc()-1));
+        request += '\n';
+        for(size_t i=1; i<item.getArgc(); i++)
+            {
+            request += item.getArgv()[i];
+            request += '\n';
+            }
+        mPipeProc.childProcessSend(request);
+        CppParserWorkerListener workerListener(listener);
+        int processExitCode;
+        mRunning = mPipeProc.childProcessListenUntil(workerListener, workerListener,
+            processExitCode);
+        if(mRunning)
+            {
+            exitCode = workerListener.getExitCode();
+            }
+        else
+            {
+            // The parser process stopped before finishing this file, so the
+            // process will be restarted for the next file.
+            mPipeProc.childProcessClose();
+            exitCode = processExitCode;
+            if(exitCode == 0)
+                {
+                exitCode = -1;
+                }
+            }
+        }
+    return success;
+    }
+
+bool CppParserWorker::canSendArgs(CppChildArgs const &item)
+    {
+    bool canSend = true;
+    for(size_t i=1; i<item.getArgc(); i++)
+        {
+        if(strpbrk(item.getArgv()[i], "\r\n"))
+            {
+            canSend = false;
+            break;
+            }
+        }
+    return canSend;
     }
 
 VerboseDumper sVerboseDump;
@@ -138,12 +331,20 @@ static void getAnalysisToolCommand(FilePath const &filePath,
         }
     else
         {
-        OovString command;
-        FilePath path(Project::getBinDirectory(), FP_Dir);
-        path.appendFile("oovCppParser");
-        command = FilePathMakeExeFilename(path);
-        args.addArg(command);
+        args.addArg(getCppParserPath());
+        }
+    }
+
+CppParserWorker &srcFileParser::getCppParserWorker()
+    {
+    LockGuard lock(mCppParserWorkersMutex);
+    std::unique_ptr<CppParserWorker> &worker =
+        mCppParserWorkers[std::this_thread::get_id()];
+    if(!worker)
+        {
+        worker.reset(new CppParserWorker());
         }
+    return *worker;
     }
 
 
@@ -165,7 +366,8 @@ bool srcFileParser::processFile(OovStringRef const srcFile)
                 OovString outFileName = Project::makeAnalysisFileName(srcFile,
                         srcRoot, mAnalysisDir);
                 OovStatus status(true, SC_File);
-                if(FileStat::isOutputOld(outFileName, srcFile, status))
+                if(mSourceFileTimes.isOutputOld(outFileName, srcFile, status) ||
+                    isIncludedFileNewer(srcFile, outFileName))
                     {
                     OovString ownerComp = mComponentFinder.getComponentTypesFile().getComponentNameOwner(srcFile);
                     mComponentFinder.setCompConfig(ownerComp);
@@ -191,7 +393,8 @@ bool srcFileParser::processFile(OovStringRef const srcFile)
                         ComponentFinder::appendArgs(false, javaArgs.getAsString(), ca);
                         }
                     sVerboseDump.logProcess(srcFile, ca.getArgv(), static_cast<int>(ca.getArgc()));
-                    addTask(ca);
+                    mPendingTasks.push_back(std::make_pair(
+                        mAnalysisDurations.getExpectedDuration(srcFile), ca));
     /*
                     sLog.logProcess(srcFile, ca.getArgv(), ca.getArgc());
                     printf("\noovBuilder Analyzing: %s\n", srcFile);
@@ -218,24 +421,81 @@ bool srcFileParser::processFile(OovStringRef const srcFile)
     return success;
     }
 
-bool srcFileParser::processItem(CppChildArgs const &item)
+bool srcFileParser::isIncludedFileNewer(OovStringRef const srcFile,
+    OovStringRef const outFileName)
     {
-    OovProcessBufferedStdListener listener(mListenerStdMutex);
-    int exitCode;
-    OovPipeProcess pipeProc;
-    OovString processStr = "\noovBuilder Analyzing: ";
+    FilePath absSrc;
+    absSrc.getAbsolutePath(srcFile, FP_File);
+    std::set<IncludedPath> incFilesSet;
+    mIncDirMap.getNestedIncludeFilesUsedBySourceFile(absSrc, incFilesSet);
+    OovStringVec incFiles;
+    for(auto const &file : incFilesSet)
+        {
+        incFiles.push_back(file.getFullPath());
+        }
+    OovStatus status(true, SC_File);
+    size_t oldIndex = 0;
+    bool old = mSourceFileTimes.isOutputOld(outFileName, incFiles, status, &oldIndex);
+    if(old)
+        {
+        sVerboseDump.logOutputOld(incFiles[oldIndex]);
+        }
+    if(status.needReport())
+        {
+        // A missing included file means that the source file must be
+        // analyzed again to update the include dependencies.
+        status.clearError();
+        }
+    return old;
+    }
+
+OovString srcFileParser::getAnalysisSrcFile(CppChildArgs const &item)
+    {
+    OovString srcFile;
     /// @todo - this is a cheat. Should use something else to indicate
     /// which arg is the filename that is being analyzed.
     if(item.getArgv()[1][0] == '-')
-        { processStr += item.getArgv()[4]; }
+        { srcFile = item.getArgv()[4]; }
     else
-        { processStr += item.getArgv()[1]; }
+        { srcFile = item.getArgv()[1]; }
+    return srcFile;
+    }
+
+bool srcFileParser::processItem(CppChildArgs const &item)
+    {
+    sBuildTrace.setWorkerQueue("analyze");
+    OovProcessBufferedStdListener listener(mListenerStdMutex);
+    int exitCode = -1;
+    OovPipeProcess pipeProc;
+    OovString srcFile = getAnalysisSrcFile(item);
+    OovString processStr = "\noovBuilder Analyzing: ";
+    processStr += srcFile;
     processStr += "\n";
     printf("%s", processStr.getStr());
     fflush(stdout);
     listener.setProcessIdStr(processStr);
-    bool success = pipeProc.spawn(item.getArgv()[0], item.getArgv(),
+#define PERSISTENT_PARSERS 1
+    bool success;
+    auto startTime = std::chrono::steady_clock::now();
+    unsigned long long startUs = sBuildTrace.getTimeUs();
+#if(PERSISTENT_PARSERS)
+    if(mCppParserPath == item.getArgv()[0] && CppParserWorker::canSendArgs(item))
+        {
+        success = getCppParserWorker().parse(item, listener, exitCode);
+        }
+    else
+#endif
+        {
+        success = pipeProc.spawn(item.getArgv()[0], item.getArgv(),
             listener, exitCode);
+        }
+    sBuildTrace.addProcess(srcFile, "analyze", startUs, exitCode);
+    if(success && exitCode == 0)
+        {
+        auto elapsed = std::chrono::steady_clock::now() - startTime;
+        mAnalysisDurations.recordDuration(srcFile, static_cast<unsigned int>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()));
+        }
     if(!success || exitCode != 0)
         {
         OovString tempStr;
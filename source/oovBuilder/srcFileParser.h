@@ -9,6 +9,12 @@
 #include <vector>
 #include "Debug.h"
 #include "OovThreadedWaitQueue.h"
+#include "OovProcess.h"
+#include "IncludeMap.h"
+#include "FileTimeCache.h"
+#include "BuildDurations.h"
+#include <memory>
+#include <thread>
 
 
 class VerboseDumper
@@ -24,6 +30,35 @@ class VerboseDumper
 extern VerboseDumper sVerboseDump;
 
 
+/// Keeps an oovCppParser running in server mode so that a process and a
+/// CLang index do not have to be created for every source file.
+/// This must only be used by one thread at a time.
+class CppParserWorker
+    {
+    public:
+        CppParserWorker():
+            mRunning(false)
+            {}
+        /// Stops the parser process.
+        ~CppParserWorker();
+        /// Sends a request to the parser process and waits for the result.
+        /// The parser process is started if it is not running.
+        /// @param item The first argument is the parser path, and the rest
+        ///     are the same arguments as when running the parser directly.
+        /// @param listener Receives the output of the parser.
+        /// @param exitCode The exit code of the parse of this file.
+        bool parse(CppChildArgs const &item, OovProcessListener &listener,
+            int &exitCode);
+        /// Returns false if an argument cannot be sent in a request because
+        /// it contains a newline. These must be parsed by a separate process.
+        static bool canSendArgs(CppChildArgs const &item);
+
+    private:
+        OovPipeProcess mPipeProc;
+        bool mRunning;
+    };
+
+
 /// Recursively finds source files, and parses the source file
 /// for static information, and saves into analysis files.
 class srcFileParser:public dirRecurser, public ThreadedWorkWaitQueue<CppChildArgs, srcFileParser>
@@ -45,7 +80,28 @@ private:
     char const * mAnalysisDir;
     OovStringVec mExcludeDirs;
     ComponentFinder &mComponentFinder;
+    /// The include dependencies from the previous analysis.
+    IncDirDependencyMapReader mIncDirMap;
+    /// The source and included files are not modified during the analysis.
+    FileTimeCache mSourceFileTimes;
+    OovString mCppParserPath;
+    // There is one parser process for each worker thread.
+    InProcMutex mCppParserWorkersMutex;
+    std::map<std::thread::id, std::unique_ptr<CppParserWorker>> mCppParserWorkers;
+    /// The durations of previous analysis are used to start the longest
+    /// files first.
+    BuildDurations mAnalysisDurations;
+    /// The files that need analysis are found before any are started so
+    /// that they can be ordered. The first is the expected duration.
+    std::vector<std::pair<unsigned int, CppChildArgs>> mPendingTasks;
 
     virtual bool processFile(OovStringRef const filePath) override;
+    /// Checks if any file that is included (nested) by the source file is
+    /// newer than the analysis output file.
+    bool isIncludedFileNewer(OovStringRef const srcFile,
+        OovStringRef const outFileName);
+    CppParserWorker &getCppParserWorker();
+    /// Returns the source file from the analysis tool arguments.
+    static OovString getAnalysisSrcFile(CppChildArgs const &item);
 };
 
@@ -564,6 +564,19 @@ OovStatusReturn FileGetFileTime(OovStringRef const path, time_t &time)
     return status;
     }
 
+OovStatusReturn FileGetFileTimeSize(OovStringRef const path, time_t &time,
+    size_t &size)
+    {
+    struct OovStat32 srcFileStat;
+    OovStatus status(OovStat32(path.getStr(), &srcFileStat) == 0, SC_File);
+    if(status.ok())
+        {
+        time = srcFileStat.st_mtime;
+        size = static_cast<size_t>(srcFileStat.st_size);
+        }
+    return status;
+    }
+
 ///////////
 
 bool FileStat::isOutputOld(OovStringRef const outputFn,
@@ -237,6 +237,14 @@ OovStatusReturn FileMakeSubDir(OovStringRef partPath);
 /// @param time The returned time of the file.
 OovStatusReturn FileGetFileTime(OovStringRef const path, time_t &time);
 
+/// Get the modify time and size of the file.
+/// This does return an error if the file does not exist.
+/// @param path The path to use to get the time.
+/// @param time The returned time of the file.
+/// @param size The returned size of the file.
+OovStatusReturn FileGetFileTimeSize(OovStringRef const path, time_t &time,
+    size_t &size);
+
 /// Delete the specified file.
 /// @param path The file to delete.
 OovStatusReturn FileDelete(OovStringRef const path);
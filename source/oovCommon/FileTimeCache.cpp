@@ -0,0 +1,119 @@
+/*
+ * FileTimeCache.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *  \copyright 2026 DCBlaha.  Distributed under the GPL.
+ */
+
+#include "FileTimeCache.h"
+#include <thread>
+#include <algorithm>
+
+
+void FileTimeCache::readFileTimes(OovStringVec const &fns)
+    {
+    size_t numThreads = std::thread::hardware_concurrency();
+    if(numThreads == 0)
+        {
+        numThreads = 1;
+        }
+    size_t filesPerThread = (fns.size() + numThreads - 1) / numThreads;
+    std::vector<std::thread> threads;
+    for(size_t startIndex=0; startIndex<fns.size(); startIndex+=filesPerThread)
+        {
+        size_t endIndex = std::min(startIndex + filesPerThread, fns.size());
+        threads.push_back(std::thread([this, &fns, startIndex, endIndex]()
+            {
+            time_t time;
+            for(size_t i=startIndex; i<endIndex; i++)
+                {
+                getCachedFileTime(fns[i], time);
+                }
+            }));
+        }
+    for(auto &thread : threads)
+        {
+        thread.join();
+        }
+    }
+
+bool FileTimeCache::getCachedFileTime(OovStringRef const fn, time_t &time)
+    {
+        {
+        std::lock_guard<std::mutex> lock(mFileTimesMutex);
+        auto const &iter = mFileTimes.find(fn.getStr());
+        if(iter != mFileTimes.end())
+            {
+            time = iter->second.mTime;
+            return iter->second.mExists;
+            }
+        }
+    // The file system is used outside of the lock so that multiple threads
+    // can wait on the file system.
+    time = 0;
+    OovStatus status = FileGetFileTime(fn, time);
+    bool exists = status.ok();
+    if(!exists)
+        {
+        status.clearError();
+        }
+    std::lock_guard<std::mutex> lock(mFileTimesMutex);
+    mFileTimes.insert(std::make_pair(std::string(fn.getStr()), FileTime(exists, time)));
+    return exists;
+    }
+
+OovStatusReturn FileTimeCache::getFileTime(OovStringRef const fn, time_t &time)
+    {
+    return OovStatus(getCachedFileTime(fn, time), SC_File);
+    }
+
+bool FileTimeCache::isOutputOld(OovStringRef const outputFn,
+        OovStringRef const inputFn, OovStatus &status)
+    {
+    OovStringVec inputs;
+    inputs.push_back(inputFn);
+    return isOutputOld(outputFn, inputs, status);
+    }
+
+bool FileTimeCache::isOutputOld(OovStringRef const outputFn,
+        OovStringVec const &inputs, OovStatus &status, size_t *oldIndex)
+    {
+    time_t outTime = 0;
+    status = FileGetFileTime(outputFn, outTime);
+    bool old = !status.ok();
+    if(status.ok())
+        {
+        for(size_t i=0; i<inputs.size(); i++)
+            {
+            time_t inTime = 0;
+            if(getCachedFileTime(inputs[i], inTime))
+                {
+                old = inTime > outTime;
+                }
+            else
+                {
+                status.set(false, SC_File);
+                old = true;
+                }
+            if(old)
+                {
+                if(oldIndex)
+                    {
+                    *oldIndex = i;
+                    }
+                break;
+                }
+            }
+        }
+    else
+        {
+        status.clearError();
+        }
+    return old;
+    }
+
+void FileTimeCache::clear()
+    {
+    std::lock_guard<std::mutex> lock(mFileTimesMutex);
+    mFileTimes.clear();
+    }
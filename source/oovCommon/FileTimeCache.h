@@ -0,0 +1,57 @@
+/*
+ * FileTimeCache.h
+ *
+ *  Created on: Oct 16, 2026
+ *  \copyright 2026 DCBlaha.  Distributed under the GPL.
+ */
+
+#ifndef FILETIMECACHE_H_
+#define FILETIMECACHE_H_
+
+#include "FilePath.h"
+#include <mutex>
+#include <unordered_map>
+
+/// This keeps the modification times of input files such as source and
+/// header files, so that headers that are included by many source files are
+/// only read from the file system once. This must only be used for files that
+/// are not modified while the cache is used, so the times of output files are
+/// not cached.
+class FileTimeCache
+    {
+    public:
+        /// Read the times of many files using multiple threads.
+        /// @param fns The file names to read.
+        void readFileTimes(OovStringVec const &fns);
+        /// Get the modification time of a file. The file system is only used
+        /// if the time of the file has not been read before.
+        /// @param fn The file name.
+        /// @param time The returned modification time.
+        OovStatusReturn getFileTime(OovStringRef const fn, time_t &time);
+        /// This is the same as FileStat::isOutputOld, except that the input
+        /// file time is cached.
+        bool isOutputOld(OovStringRef const outputFn,
+            OovStringRef const inputFn, OovStatus &status);
+        /// This is the same as FileStat::isOutputOld, except that the input
+        /// file times are cached, and the output file time is only read once.
+        bool isOutputOld(OovStringRef const outputFn,
+            OovStringVec const &inputs, OovStatus &status, size_t *oldIndex=nullptr);
+        void clear();
+
+    private:
+        struct FileTime
+            {
+            FileTime(bool exists, time_t time):
+                mExists(exists), mTime(time)
+                {}
+            bool mExists;
+            time_t mTime;
+            };
+        std::mutex mFileTimesMutex;
+        std::unordered_map<std::string, FileTime> mFileTimes;
+
+        /// Returns true if the file exists.
+        bool getCachedFileTime(OovStringRef const fn, time_t &time);
+    };
+
+#endif /* FILETIMECACHE_H_ */
@@ -7,12 +7,21 @@
 
 #include "IncludeMap.h"
 #include "Components.h"         // For isHeader
+#include "Project.h"
+#include "DirList.h"
 #include "Debug.h"
 #include "OovError.h"
 #include <algorithm>
 
 OovStatusReturn IncDirDependencyMapReader::read(OovStringRef const fn)
     {
+        {
+        std::lock_guard<std::mutex> lock(mClosureGraphMutex);
+        mClosureGraph.clear();
+        mDirectIncludes.clear();
+        mDirectIncluders.clear();
+        mDirectMapsBuilt = false;
+        }
     setFilename(fn);
     // It is ok if the include map is not present the first time.
     OovStatus status(true, SC_File);
@@ -159,17 +168,71 @@ void IncDirDependencyMapReader::getImmediateIncludeFilesUsedBySourceFile(
     incFiles.insert(curIncFiles.begin(), curIncFiles.end());
     }
 
-/// This is recursive.
+void IncDirDependencyMapReader::buildDirectMaps() const
+    {
+    for(auto const &nameVal : getNameValues())
+        {
+        std::set<IncludedPath> &incFiles = mDirectIncludes[nameVal.first];
+        getImmediateIncludeFilesUsedBySourceFile(nameVal.first, incFiles);
+        for(auto const &incFile : incFiles)
+            {
+            mDirectIncluders[incFile.getFullPath()].insert(nameVal.first);
+            }
+        }
+    mDirectMapsBuilt = true;
+    }
+
+void IncDirDependencyMapReader::getDirectIncludeFiles(OovStringRef const srcName,
+        std::set<IncludedPath> &incFiles) const
+    {
+    FilePath fp(srcName, FP_File);
+    std::lock_guard<std::mutex> lock(mClosureGraphMutex);
+    if(!mDirectMapsBuilt)
+        {
+        buildDirectMaps();
+        }
+    auto const &iter = mDirectIncludes.find(fp);
+    if(iter != mDirectIncludes.end())
+        {
+        incFiles.insert((*iter).second.begin(), (*iter).second.end());
+        }
+    }
+
+void IncDirDependencyMapReader::getDirectIncluders(OovStringRef const incName,
+        OovStringSet &includerFiles) const
+    {
+    std::lock_guard<std::mutex> lock(mClosureGraphMutex);
+    if(!mDirectMapsBuilt)
+        {
+        buildDirectMaps();
+        }
+    auto const &iter = mDirectIncluders.find(incName);
+    if(iter != mDirectIncluders.end())
+        {
+        includerFiles.insert((*iter).second.begin(), (*iter).second.end());
+        }
+    }
+
 void IncDirDependencyMapReader::getNestedIncludeFilesUsedBySourceFile(
         OovStringRef const srcName, std::set<IncludedPath> &incFiles) const
     {
     FilePath fp(srcName, FP_File);
-    OovString val = getValue(fp);
-    processIncPath(val, incFiles,
-            [this, &incFiles](IncludedPath const &incPath) mutable
+    IncludeClosureGraph::ClosurePtr closure;
+        {
+        std::lock_guard<std::mutex> lock(mClosureGraphMutex);
+        if(!mClosureGraph.isBuilt())
+            {
+            mClosureGraph.build(getNameValues());
+            }
+        closure = mClosureGraph.getNestedIncludes(fp);
+        }
+    if(closure)
         {
-        getNestedIncludeFilesUsedBySourceFile(incPath.getFullPath(), incFiles);
-        });
+        for(size_t fileIndex : *closure)
+            {
+            incFiles.insert(mClosureGraph.getIncludedPath(fileIndex));
+            }
+        }
     expandJavaFiles(incFiles);
     }
 
@@ -386,3 +449,262 @@ OovStringVec IncDirDependencyMapReader::getOrderedIncludeDirsForSourceFile(OovSt
     return incDirs;
     }
 
+
+const size_t IncludeClosureGraph::NoIndex;
+
+void IncludeClosureGraph::clear()
+    {
+    mBuilt = false;
+    mFiles.clear();
+    mFileIndices.clear();
+    mComponentFiles.clear();
+    mComponentClosures.clear();
+    }
+
+size_t IncludeClosureGraph::getFileIndex(IncludedPath const &path, bool included)
+    {
+    FilePath fp(path.getFullPath(), FP_File);
+    auto const &ret = mFileIndices.insert(std::make_pair(fp, mFiles.size()));
+    if(ret.second)
+        {
+        mFiles.push_back(FileNode(path, included));
+        }
+    else if(included && !mFiles[ret.first->second].mIncluded)
+        {
+        FileNode &file = mFiles[ret.first->second];
+        file.mPath = path;
+        file.mIncluded = true;
+        }
+    return ret.first->second;
+    }
+
+void IncludeClosureGraph::build(std::map<OovString, OovString> const &nameValues)
+    {
+    clear();
+    for(auto const &nameVal : nameValues)
+        {
+        size_t includerIndex = getFileIndex(IncludedPath("", nameVal.first), false);
+        std::set<IncludedPath> incFiles;
+        processIncPath(nameVal.second, incFiles,
+            [this, includerIndex](IncludedPath const &incPath)
+            {
+            size_t includedIndex = getFileIndex(incPath, true);
+            mFiles[includerIndex].mIncludedIndices.push_back(includedIndex);
+            });
+        }
+    findComponents();
+    mComponentClosures.resize(mComponentFiles.size());
+    mBuilt = true;
+    }
+
+/// This uses Tarjan's algorithm to find the strongly connected components.
+/// It is iterative to prevent deep recursion for long include chains.
+void IncludeClosureGraph::findComponents()
+    {
+    std::vector<size_t> visitOrder(mFiles.size(), NoIndex);
+    std::vector<size_t> lowLink(mFiles.size());
+    std::vector<bool> onStack(mFiles.size(), false);
+    std::vector<size_t> componentStack;
+    // Pairs of file index and the next included index to visit.
+    std::vector<std::pair<size_t, size_t>> callStack;
+    size_t visitIndex = 0;
+    for(size_t startIndex=0; startIndex<mFiles.size(); startIndex++)
+        {
+        if(visitOrder[startIndex] != NoIndex)
+            {
+            continue;
+            }
+        callStack.push_back(std::make_pair(startIndex, 0));
+        while(callStack.size() > 0)
+            {
+            size_t fileIndex = callStack.back().first;
+            size_t &edgeIndex = callStack.back().second;
+            if(edgeIndex == 0 && visitOrder[fileIndex] == NoIndex)
+                {
+                visitOrder[fileIndex] = visitIndex;
+                lowLink[fileIndex] = visitIndex;
+                visitIndex++;
+                componentStack.push_back(fileIndex);
+                onStack[fileIndex] = true;
+                }
+            std::vector<size_t> const &included = mFiles[fileIndex].mIncludedIndices;
+            if(edgeIndex < included.size())
+                {
+                size_t includedIndex = included[edgeIndex++];
+                if(visitOrder[includedIndex] == NoIndex)
+                    {
+                    callStack.push_back(std::make_pair(includedIndex, 0));
+                    }
+                else if(onStack[includedIndex])
+                    {
+                    lowLink[fileIndex] = std::min(lowLink[fileIndex],
+                        visitOrder[includedIndex]);
+                    }
+                }
+            else
+                {
+                if(lowLink[fileIndex] == visitOrder[fileIndex])
+                    {
+                    size_t componentIndex = mComponentFiles.size();
+                    mComponentFiles.push_back(std::vector<size_t>());
+                    size_t memberIndex;
+                    do
+                        {
+                        memberIndex = componentStack.back();
+                        componentStack.pop_back();
+                        onStack[memberIndex] = false;
+                        mFiles[memberIndex].mComponentIndex = componentIndex;
+                        mComponentFiles[componentIndex].push_back(memberIndex);
+                        } while(memberIndex != fileIndex);
+                    }
+                callStack.pop_back();
+                if(callStack.size() > 0)
+                    {
+                    size_t includerIndex = callStack.back().first;
+                    lowLink[includerIndex] = std::min(lowLink[includerIndex],
+                        lowLink[fileIndex]);
+                    }
+                }
+            }
+        }
+    }
+
+/// The components are found in reverse topological order, so the closures
+/// of the included components do not depend on this component.
+IncludeClosureGraph::ClosurePtr IncludeClosureGraph::getComponentClosure(
+    size_t componentIndex)
+    {
+    ClosurePtr &closure = mComponentClosures[componentIndex];
+    if(!closure)
+        {
+        std::vector<size_t> fileIndices;
+        for(size_t fileIndex : mComponentFiles[componentIndex])
+            {
+            for(size_t includedIndex : mFiles[fileIndex].mIncludedIndices)
+                {
+                fileIndices.push_back(includedIndex);
+                size_t includedComponent = mFiles[includedIndex].mComponentIndex;
+                if(includedComponent != componentIndex)
+                    {
+                    ClosurePtr includedClosure = getComponentClosure(includedComponent);
+                    fileIndices.insert(fileIndices.end(), includedClosure->begin(),
+                        includedClosure->end());
+                    }
+                }
+            }
+        std::sort(fileIndices.begin(), fileIndices.end());
+        fileIndices.erase(std::unique(fileIndices.begin(), fileIndices.end()),
+            fileIndices.end());
+        closure = std::make_shared<std::vector<size_t> const>(std::move(fileIndices));
+        }
+    return closure;
+    }
+
+IncludeClosureGraph::ClosurePtr IncludeClosureGraph::getNestedIncludes(
+    OovStringRef const fn)
+    {
+    ClosurePtr closure;
+    auto const &iter = mFileIndices.find(fn);
+    if(iter != mFileIndices.end())
+        {
+        closure = getComponentClosure(mFiles[iter->second].mComponentIndex);
+        }
+    return closure;
+    }
+
+
+OovStatusReturn IncDirDependencyMapMerger::merge(OovStringRef const analysisDir)
+    {
+    FilePath fragmentDir(analysisDir, FP_Dir);
+    fragmentDir.appendDir(Project::getAnalysisIncDepsFragmentDirName());
+    OovStatus status(true, SC_File);
+    std::vector<std::string> fragmentFns;
+    if(FileIsDirOnDisk(fragmentDir, status))
+        {
+        status = getDirListMatchExt(fragmentDir, FilePath("txt", FP_Ext),
+            fragmentFns);
+        }
+    if(status.ok() && fragmentFns.size() > 0)
+        {
+        FilePath mapFn(analysisDir, FP_Dir);
+        mapFn.appendFile(Project::getAnalysisIncDepsFilename());
+        setFilename(mapFn);
+        SharedFile file;
+        status = writeFileExclusiveReadUpdate(file);
+        bool anyChanges = false;
+        for(auto const &fragmentFn : fragmentFns)
+            {
+            if(!status.ok())
+                {
+                break;
+                }
+            NameValueFile fragment(fragmentFn);
+            status = fragment.readFile();
+            if(status.ok())
+                {
+                for(auto const &nameVal : fragment.getNameValues())
+                    {
+                    CompoundValue newIncludedInfo;
+                    newIncludedInfo.parseString(nameVal.second);
+                    if(newIncludedInfo.size() <= IncDirMapNumTimeVals)
+                        {
+                        // The includer no longer includes any files.
+                        if(getValue(nameVal.first).length() > 0)
+                            {
+                            removeName(nameVal.first);
+                            anyChanges = true;
+                            }
+                        }
+                    else if(includedPathsChanged(nameVal.first, newIncludedInfo))
+                        {
+                        setNameValue(nameVal.first, nameVal.second);
+                        anyChanges = true;
+                        }
+                    }
+                status = FileDelete(fragmentFn);
+                }
+            }
+        if(status.ok() && anyChanges)
+            {
+            status = writeFileExclusive(file);
+            }
+        }
+    if(status.needReport())
+        {
+        OovString str = "Unable to merge include map fragments: ";
+        str += fragmentDir;
+        status.report(ET_Error, str);
+        }
+    return status;
+    }
+
+// Gets the directory/filename pairs that follow the time values. The pairs
+// are kept together since the same file can be found in a different directory.
+static std::set<std::pair<OovString, OovString>> getIncludedPathPairs(
+    CompoundValue const &includedInfo)
+    {
+    std::set<std::pair<OovString, OovString>> pathPairs;
+    for(size_t i=IncDirMapNumTimeVals; i+1<includedInfo.size();
+            i+=IncDirMapNumTimeVals)
+        {
+        pathPairs.insert(std::make_pair(includedInfo[i], includedInfo[i+1]));
+        }
+    return pathPairs;
+    }
+
+bool IncDirDependencyMapMerger::includedPathsChanged(OovStringRef includerFn,
+    CompoundValue const &newIncludedInfo) const
+    {
+    CompoundValue origIncludedInfo;
+    origIncludedInfo.parseString(getValue(includerFn));
+    bool changed = (origIncludedInfo.size() != newIncludedInfo.size());
+    if(!changed)
+        {
+        // Skip the time values, and compare the included paths.
+        // The order of the paths is not important.
+        changed = (getIncludedPathPairs(origIncludedInfo) !=
+            getIncludedPathPairs(newIncludedInfo));
+        }
+    return changed;
+    }
+
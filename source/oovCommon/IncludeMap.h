@@ -10,6 +10,10 @@
 
 #include <string>
 #include <set>
+#include <map>
+#include <vector>
+#include <memory>
+#include <mutex>
 #include "NameValueFile.h"
 
 static const int IncDirMapNumTimeVals = 2;
@@ -54,10 +58,65 @@ struct IncludedPath
 
 void discardDirs(OovStringVec &dirs);
 
+/// This is an include graph where every includer and included file is an
+/// index. The nested include closures are cached so that the same header
+/// files do not have to be searched again for every source file.
+class IncludeClosureGraph
+    {
+    public:
+        /// A sorted list of file indices.
+        typedef std::shared_ptr<std::vector<size_t> const> ClosurePtr;
+
+        IncludeClosureGraph():
+            mBuilt(false)
+            {}
+        /// Build the graph from the values of the include dependency map.
+        void build(std::map<OovString, OovString> const &nameValues);
+        void clear();
+        bool isBuilt() const
+            { return mBuilt; }
+        /// Get the nested included file indices for a file. This returns
+        /// nullptr if the file does not include any files.
+        /// @param fn The includer file name.
+        ClosurePtr getNestedIncludes(OovStringRef const fn);
+        IncludedPath const &getIncludedPath(size_t fileIndex) const
+            { return mFiles[fileIndex].mPath; }
+
+    private:
+        static const size_t NoIndex = static_cast<size_t>(-1);
+        struct FileNode
+            {
+            FileNode(IncludedPath const &path, bool included):
+                mPath(path), mIncluded(included), mComponentIndex(NoIndex)
+                {}
+            IncludedPath mPath;
+            /// False if the path is only known as an includer, and does not
+            /// have the include search directory.
+            bool mIncluded;
+            std::vector<size_t> mIncludedIndices;
+            /// The index of the strongly connected component.
+            size_t mComponentIndex;
+            };
+        bool mBuilt;
+        std::vector<FileNode> mFiles;
+        std::map<OovString, size_t> mFileIndices;
+        /// The file indices for each strongly connected component (files that
+        /// include each other). These all have the same closure.
+        std::vector<std::vector<size_t>> mComponentFiles;
+        std::vector<ClosurePtr> mComponentClosures;
+
+        size_t getFileIndex(IncludedPath const &path, bool included);
+        void findComponents();
+        ClosurePtr getComponentClosure(size_t componentIndex);
+    };
+
 /// See the oovCppParser project for a definition of the file that this reads.
 class IncDirDependencyMapReader:public NameValueFile
     {
     public:
+        IncDirDependencyMapReader():
+            mDirectMapsBuilt(false)
+            {}
         /// Read the include dependency map file
         /// @param fn The file name to read from
         OovStatusReturn read(OovStringRef const fn);
@@ -66,6 +125,19 @@ class IncDirDependencyMapReader:public NameValueFile
         /// @param incFiles The returned list of included files
         void getImmediateIncludeFilesUsedBySourceFile(
                 OovStringRef const srcName, std::set<IncludedPath> &incFiles) const;
+        /// This returns the same files as
+        /// getImmediateIncludeFilesUsedBySourceFile, but uses the include
+        /// files that were parsed once for all source files.
+        /// @param srcName The source file name
+        /// @param incFiles The returned list of included files
+        void getDirectIncludeFiles(OovStringRef const srcName,
+                std::set<IncludedPath> &incFiles) const;
+        /// Get the files that directly include a file. This uses a reverse
+        /// map that is built once for all files.
+        /// @param incName The full path of the included file.
+        /// @param includerFiles The returned includer file names.
+        void getDirectIncluders(OovStringRef const incName,
+                OovStringSet &includerFiles) const;
         /// Get all included files used by a source file.
         /// This recursively finds all include files for the specified
         /// interface or implementation source file name.
@@ -128,6 +200,41 @@ class IncDirDependencyMapReader:public NameValueFile
             OovStringRef const dirName) const;
         // Accepts an include path to support a java style wildcard import.
         OovStringVec getJavaExpandedFiles(OovStringRef const incPath) const;
+
+        /// The closure graph is built the first time nested includes are
+        /// needed after reading the file. The direct maps are built the
+        /// first time that direct includes or includers are needed. The
+        /// mutex protects both.
+        mutable std::mutex mClosureGraphMutex;
+        mutable IncludeClosureGraph mClosureGraph;
+        /// The direct include files for each includer file name.
+        mutable std::map<OovString, std::set<IncludedPath>> mDirectIncludes;
+        /// The direct includer file names for each included full path.
+        mutable std::map<OovString, OovStringSet> mDirectIncluders;
+        mutable bool mDirectMapsBuilt;
+
+        /// The mutex must be locked before calling this.
+        void buildDirectMaps() const;
+    };
+
+/// The parsers write the include dependencies for each parsed source file
+/// into a separate fragment file. This merges the fragment files into the
+/// include dependency map file once after the analysis, so that the parsers
+/// do not have to lock and rewrite the shared map file for every source file.
+class IncDirDependencyMapMerger:public NameValueFile
+    {
+    public:
+        /// Merge the fragment files into the map file, and delete the
+        /// fragment files.
+        /// @param analysisDir The directory that contains the map file and
+        ///     the fragment directory.
+        OovStatusReturn merge(OovStringRef const analysisDir);
+
+    private:
+        /// Only the changed includers are updated so that the original
+        /// update time is kept for unchanged includers.
+        bool includedPathsChanged(OovStringRef includerFn,
+            CompoundValue const &newIncludedInfo) const;
     };
 
 #endif /* INCLUDEMAP_H_ */
@@ -446,6 +446,15 @@ void ModelData::clear()
     {
     mModules.clear();
     mAssociations.clear();
+    mTypeNameIndex.clear();
+    mTypeReferences.clear();
+    mTypeReferencesIndexed = false;
+    mOperationCallers.clear();
+    mCallsIndexed = false;
+    mTypeUsers.clear();
+    mTypeUsersIndexed = false;
+    mTypeReplacements.clear();
+    mReplacedTypes.clear();
     mTypes.clear();
     }
 
@@ -468,13 +477,13 @@ void ModelData::dumpTypes()
 const ModelType *ModelData::getTypeRef(OovStringRef const typeName) const
     {
     OovString baseTypeName = getBaseType(typeName);
-    return findType(baseTypeName);
+    return findBaseType(baseTypeName);
     }
 
 ModelType *ModelData::createOrGetTypeRef(OovStringRef const typeName, eModelDataTypes dtype)
     {
     std::string baseTypeName = getBaseType(typeName);
-    ModelType *type = findType(baseTypeName);
+    ModelType *type = const_cast<ModelType*>(findBaseType(baseTypeName));
     if(!type)
         {
         type = static_cast<ModelType*>(createDataType(dtype, baseTypeName));
@@ -633,20 +642,33 @@ static inline bool compareStrs(OovStringRef const tstr1, OovStringRef const tstr
     return (strcmp(tstr1, tstr2) < 0);
     }
 
-#define BINARYSPEED 1
+size_t ModelData::TypeNameHash::operator()(char const *name) const
+    {
+    // FNV-1a
+    size_t hash = 2166136261u;
+    for(char const *p = name; *p; p++)
+        {
+        hash = (hash ^ static_cast<unsigned char>(*p)) * 16777619u;
+        }
+    return hash;
+    }
 
 void ModelData::addType(std::unique_ptr<ModelType> &&type)
     {
-#if(BINARYSPEED)
     std::string baseTypeName = getBaseType(type->getName());
     type->setName(baseTypeName);
-    auto it = std::upper_bound(mTypes.begin(), mTypes.end(), baseTypeName,
-        [](OovStringRef const mod1Name, std::unique_ptr<ModelType> &mod2) -> bool
-        { return(compareStrs(mod1Name, mod2->getName())); } );
-    mTypes.insert(it, std::move(type));
-#else
-    mTypes.push_back(type);
-#endif
+    // If there are types with the same name, the first one is found.
+    mTypeNameIndex.insert(std::make_pair(type->getName().getStr(), type.get()));
+    mTypes.push_back(std::move(type));
+    }
+
+void ModelData::sortTypes()
+    {
+    // The stable sort keeps types with the same name in the order they were
+    // added.
+    std::stable_sort(mTypes.begin(), mTypes.end(),
+        [](std::unique_ptr<ModelType> const &type1, std::unique_ptr<ModelType> const &type2)
+        { return(compareStrs(type1->getName(), type2->getName())); } );
     }
 
 /*
@@ -662,31 +684,30 @@ static OovString getTemplateUseBaseName(OovString const &name)
     }
 */
 
-const ModelType *ModelData::findType(OovStringRef const name) const
+const ModelType *ModelData::findBaseType(OovStringRef const baseTypeName) const
     {
     const ModelType *type = nullptr;
-#if(BINARYSPEED)
-    // This comparison must produce the same sort order as addType.
-    std::string baseTypeName = getBaseType(name);
-    auto iter = std::lower_bound(mTypes.begin(), mTypes.end(), baseTypeName,
-        [](std::unique_ptr<ModelType> const &mod1, OovStringRef const mod2Name) -> bool
-        { return(compareStrs(mod1->getName(), mod2Name)); } );
-    if(iter != mTypes.end())
+    auto iter = mTypeNameIndex.find(baseTypeName.getStr());
+    if(iter != mTypeNameIndex.end())
         {
-        if(baseTypeName.compare((*iter)->getName()) == 0)
-            type = (*iter).get();
+        type = (*iter).second;
         }
-#else
-    std::string baseTypeName = getBaseType(name);
-    for(auto &iterType : mTypes)
+    return type;
+    }
+
+const ModelType *ModelData::findType(OovStringRef const name) const
+    {
+    // Most names are already base type names, so try the name first to
+    // prevent making a base type name string.
+    const ModelType *type = findBaseType(name);
+    if(!type)
         {
-        if(iterType->getName().compare(baseTypeName) == 0)
+        std::string baseTypeName = getBaseType(name);
+        if(baseTypeName.compare(name) != 0)
             {
-            type = iterType;
-            break;
+            type = findBaseType(baseTypeName);
             }
         }
-#endif
     return type;
     }
 
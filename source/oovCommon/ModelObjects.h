@@ -26,6 +26,8 @@
 #include <list>
 #include <vector>
 #include <memory>
+#include <unordered_map>
+#include <map>
 #include <string.h>
 #include "OovString.h"
 
@@ -761,12 +763,72 @@ class ConstModelClassifierVector:public std::vector<ModelClassifier const *>
         bool addUnique(ModelClassifier const *cl);
     };
 
+/// A place in the model that refers to a type. The references are found
+/// in attributes, operations and associations.
+class ModelTypeReference
+    {
+    public:
+        ModelTypeReference(ModelTypeRef *typeRef, ModelClassifier const *classifier,
+                ModelOperation const *oper):
+            mTypeRef(typeRef), mAssociation(nullptr), mClassifier(classifier),
+            mOperation(oper)
+            {}
+        ModelTypeReference(ModelAssociation *assoc):
+            mTypeRef(nullptr), mAssociation(assoc), mClassifier(nullptr),
+            mOperation(nullptr)
+            {}
+        /// This is nullptr for associations.
+        ModelTypeRef *mTypeRef;
+        /// This is only set for associations.
+        ModelAssociation *mAssociation;
+        /// The class that contains the attribute or operation.
+        ModelClassifier const *mClassifier;
+        /// This is nullptr for attributes and associations.
+        ModelOperation const *mOperation;
+    };
+
+enum eModelTypeUserKinds { MTU_TemplateArg, MTU_Member, MTU_FuncParam,
+    MTU_FuncBodyVar };
+
+/// A type that uses another type.
+class ModelTypeUser
+    {
+    public:
+        ModelTypeUser(ModelType const *user, eModelTypeUserKinds kind):
+            mUser(user), mKind(kind)
+            {}
+        bool operator==(ModelTypeUser const &user) const
+            { return(mUser == user.mUser && mKind == user.mKind); }
+        /// For MTU_TemplateArg, this is the template type that has the used
+        /// type as an argument. For the others, this is the class that has a
+        /// member, function parameter or function body variable of the used type.
+        ModelType const *mUser;
+        eModelTypeUserKinds mKind;
+    };
+
+/// An operation that calls another operation.
+class ModelOperationCaller
+    {
+    public:
+        ModelOperationCaller(ModelClassifier const *cls, ModelOperation const *oper):
+            mClassifier(cls), mOperation(oper)
+            {}
+        ModelClassifier const *mClassifier;
+        ModelOperation const *mOperation;
+    };
+
 
 /// Holds all data used to make class and sequence diagrams. This data is read
 /// from the XMI files.
 class ModelData
     {
     public:
+        ModelData():
+            mTypeReferencesIndexed(false), mCallsIndexed(false),
+            mTypeUsersIndexed(false)
+            {}
+        // The types are in the order they were added until resolveModelIds
+        // sorts them by name.
         std::vector<std::unique_ptr<ModelType>> mTypes;                 // Some of these (otClasses) are Nodes
         std::vector<std::unique_ptr<ModelAssociation>> mAssociations;   // Edges
         std::vector<std::unique_ptr<ModelModule>> mModules;
@@ -776,7 +838,22 @@ class ModelData
         void clear();
         /// Use the model ids from the file to resolve references.  This should
         /// be done for every loaded file since ID's are specific for each file.
+        /// This also sorts the types by name and indexes the type references.
         void resolveModelIds();
+        /// Builds an index from each type to the places that refer to the type,
+        /// and updates references to types that were replaced by replaceType
+        /// before the index was built. This must be done again if references
+        /// are changed other than by replaceType, or if statements are added
+        /// to operations, since the index points into the statements.
+        void indexTypeReferences();
+        /// Builds an index from each called operation to the operations that
+        /// call it. This is done by resolveModelIds, and must be done again
+        /// if statements are changed.
+        void indexCalls();
+        /// Builds an index from each type to the types that use it. This is
+        /// done by resolveModelIds, and must be done again if types are
+        /// added or changed.
+        void indexTypeUsers();
 
         bool isTypeReferencedByOperation(ModelOperation const &oper,
             ModelType const &type) const;
@@ -790,14 +867,48 @@ class ModelData
             ModelType const &type) const;
 
         /// Go through the classes and operations and see if the type is
-        /// referenced as a supplier.
+        /// referenced as a supplier. This uses the type reference index if
+        /// it has been built.
+        /// See indexTypeReferences.
         /// This is used by the model writer, so it has one
         /// strange rule. If a type is related by inheritance in any way,
         /// then indicate it is referenced. Should this be changed?
         /// @param type The type to check.
         bool isTypeReferencedByDefinedObjects(ModelType const &type) const;
 
-        /// Add a type to the model.
+        /// Get the associations where the class is either the parent or the
+        /// child. This uses the type reference index if it has been built,
+        /// otherwise all associations are searched.
+        /// @param classifier The class to find associations of.
+        /// @param assocs The returned associations.
+        void getAssociations(ModelClassifier const &classifier,
+            std::vector<ModelAssociation const *> &assocs) const;
+
+        /// Get the operations that call an operation. Each caller is only
+        /// listed once, in the order of the types in the model. This uses
+        /// the call index if it has been built, otherwise all statements are
+        /// searched.
+        /// See indexCalls.
+        /// @param calleeClass The class of the called operation.
+        /// @param calleeOperName The name of the called operation.
+        /// @param callers The returned callers.
+        void getOperationCallers(ModelClassifier const &calleeClass,
+            OovStringRef const calleeOperName,
+            std::vector<ModelOperationCaller> &callers) const;
+
+        /// Get the types that use a type as a template argument, member,
+        /// function parameter or function body variable. Each user is only
+        /// listed once for each kind of use, in the order of the types in the
+        /// model. This uses the type user index if it has been built,
+        /// otherwise all types are searched.
+        /// See indexTypeUsers.
+        /// @param type The used type.
+        /// @param users The returned users.
+        void getTypeUsers(ModelType const &type,
+            std::vector<ModelTypeUser> &users) const;
+
+        /// Add a type to the model. The name of the type is changed to the
+        /// base type name.
         /// @param type The type to add.
         void addType(std::unique_ptr<ModelType> &&type);
 
@@ -823,13 +934,16 @@ class ModelData
         /// @param typeName The name of the type to retrieve.
         ModelType *findType(OovStringRef const typeName);
 
-        /// Find a type.
+        /// Find a type. This does not allocate memory if the name is
+        /// already a base type name of a type in the model.
         /// @param typeName The name of the type to retrieve.
         const ModelType *findType(OovStringRef const typeName) const;
 
         /// Replace a type.
         /// For all pointers to the old type, sets to the new type, then
-        /// deletes the old type.
+        /// deletes the old type. If the type references have not been indexed,
+        /// only the associations are updated now, and the other references
+        /// are updated by indexTypeReferences.
         /// @param existingType The original type.
         /// @param newType The new type.
         void replaceType(ModelType *existingType, ModelClassifier *newType);
@@ -888,16 +1002,60 @@ class ModelData
         static std::string getBaseType(OovStringRef const fullStr);
 
     private:
+        struct TypeNameHash
+            {
+            size_t operator()(char const *name) const;
+            };
+        struct TypeNameEqual
+            {
+            bool operator()(char const *name1, char const *name2) const
+                { return(strcmp(name1, name2) == 0); }
+            };
+        /// An index of mTypes by the base type name. The keys point to the
+        /// names of the types so that lookups do not need to make strings.
+        std::unordered_map<char const *, ModelType *, TypeNameHash,
+            TypeNameEqual> mTypeNameIndex;
+        /// An index from each type to the places that refer to the type.
+        std::unordered_map<ModelType const *, std::vector<ModelTypeReference>>
+            mTypeReferences;
+        bool mTypeReferencesIndexed;
+        typedef std::pair<ModelClassifier const *, std::string> CalleeKey;
+        /// An index from the called class and operation name to the
+        /// operations that call it.
+        std::map<CalleeKey, std::vector<ModelOperationCaller>> mOperationCallers;
+        bool mCallsIndexed;
+        /// An index from each type to the types that use it.
+        std::unordered_map<ModelType const *, std::vector<ModelTypeUser>>
+            mTypeUsers;
+        bool mTypeUsersIndexed;
+        /// Types that were replaced before the references were indexed.
+        /// The key is the replaced type, and the value is the new type.
+        std::unordered_map<ModelType const *, ModelClassifier *> mTypeReplacements;
+        /// The replaced types are kept until the references to them are updated.
+        std::vector<std::unique_ptr<ModelType>> mReplacedTypes;
+
         ModelObject *createDataType(eModelDataTypes type, const std::string &id);
+        /// Gets the types that are used by a type, in the order that the
+        /// type users are listed.
+        /// @param userType The type that uses the other types.
+        /// @param usedTypes The returned used types. The kind is the kind of
+        ///     use by the user type.
+        void getUsedTypes(ModelType const &userType,
+            std::vector<std::pair<ModelType const *, eModelTypeUserKinds>> &usedTypes) const;
+        /// Find a type using the name that has already been converted to a
+        /// base type name.
+        const ModelType *findBaseType(OovStringRef const baseTypeName) const;
+        /// Sort the types by name.
+        void sortTypes();
         void resolveStatements(class TypeIdMap const &typeMap, ModelStatements &stmt);
         void resolveDecl(class TypeIdMap const &typeMap, ModelTypeRef &decl);
         bool isTypeReferencedByStatements(ModelStatements const &stmts, ModelType const &type) const;
         void dumpTypes();
-        /// Replace a statement
-        void replaceStatementType(ModelStatements &stmts, ModelType *existingType,
-                ModelClassifier *newType);
-        /// Erase a type.
-        void eraseType(ModelType *existingType);
+        void addTypeReference(ModelTypeRef &typeRef, ModelClassifier const *classifier,
+                ModelOperation const *oper);
+        /// Remove a type from the types and the name index.
+        /// @return The removed type.
+        std::unique_ptr<ModelType> removeType(ModelType *existingType);
         /// Find a template definition type.  This discards the parameters
         /// to find the template class type.
         /// @param baseIdentName The identifier part of the name of the type
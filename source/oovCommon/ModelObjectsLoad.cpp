@@ -77,6 +77,7 @@ void ModelData::resolveDecl(TypeIdMap const &typeMap, ModelTypeRef &decl)
 
 void ModelData::resolveModelIds()
     {
+    sortTypes();
     dumpTypes();
     TypeIdMap typeMap(mTypes);
     // Resolve class member attributes and operations.
@@ -124,6 +125,9 @@ void ModelData::resolveModelIds()
 */
             }
         }
+    indexTypeReferences();
+    indexCalls();
+    indexTypeUsers();
 /*
     for(auto &type : mTypes)
         {
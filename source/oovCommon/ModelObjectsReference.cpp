@@ -106,48 +106,349 @@ bool ModelData::isTypeReferencedByClassAttributes(ModelClassifier const &classif
     return referenced;
     }
 
-bool ModelData::isTypeReferencedByDefinedObjects(ModelType const &checkType) const
+void ModelData::addTypeReference(ModelTypeRef &typeRef,
+    ModelClassifier const *classifier, ModelOperation const *oper)
     {
-    bool referenced = false;
+    ModelType const *type = typeRef.getDeclType();
+    if(type)
+        {
+        auto const &replaceIter = mTypeReplacements.find(type);
+        if(replaceIter != mTypeReplacements.end())
+            {
+            type = (*replaceIter).second;
+            typeRef.setDeclType(type);
+            }
+        mTypeReferences[type].push_back(ModelTypeReference(&typeRef,
+            classifier, oper));
+        }
+    }
+
+void ModelData::indexTypeReferences()
+    {
+    mTypeReferences.clear();
     for(const auto &type : mTypes)
         {
         if(type->getDataType() == DT_Class)
             {
             ModelClassifier *classifier = ModelClassifier::getClass(type.get());
-            // Only defined classes in the parsed translation unit have a module.
-            if(classifier->getModule())
+            for(auto &attr : classifier->getAttributes())
                 {
-                referenced = isTypeReferencedByClassAttributes(*classifier, checkType);
+                addTypeReference(*attr, classifier, nullptr);
                 }
-            if(!referenced)
+            for(auto &oper : classifier->getOperations())
                 {
-                for(auto &oper : classifier->getOperations())
+                for(auto &param : oper->getParams())
                     {
-                    referenced = isTypeReferencedByOperation(*oper, checkType);
-                    if(referenced)
+                    addTypeReference(*param, classifier, oper.get());
+                    }
+                for(auto &stmt : oper->getStatements())
+                    {
+                    if(stmt.getStatementType() == ST_Call ||
+                            stmt.getStatementType() == ST_VarRef)
                         {
-                        break;
+                        addTypeReference(stmt.getClassDecl(), classifier, oper.get());
+                        if(stmt.getStatementType() == ST_VarRef)
+                            {
+                            addTypeReference(stmt.getVarDecl(), classifier, oper.get());
+                            }
                         }
                     }
+                for(auto &vd : oper->getBodyVarDeclarators())
+                    {
+                    addTypeReference(*vd, classifier, oper.get());
+                    }
+                addTypeReference(oper->getReturnType(), classifier, oper.get());
                 }
-            if(referenced)
+            }
+        }
+    for(auto &assoc : mAssociations)
+        {
+        if(assoc->getChild())
+            {
+            mTypeReferences[assoc->getChild()].push_back(
+                ModelTypeReference(assoc.get()));
+            }
+        if(assoc->getParent() && assoc->getParent() != assoc->getChild())
+            {
+            mTypeReferences[assoc->getParent()].push_back(
+                ModelTypeReference(assoc.get()));
+            }
+        }
+    mTypeReplacements.clear();
+    mReplacedTypes.clear();
+    mTypeReferencesIndexed = true;
+    }
+
+bool ModelData::isTypeReferencedByDefinedObjects(ModelType const &checkType) const
+    {
+    bool referenced = false;
+    if(mTypeReferencesIndexed)
+        {
+        auto const &iter = mTypeReferences.find(&checkType);
+        if(iter != mTypeReferences.end())
+            {
+            for(auto const &ref : (*iter).second)
                 {
-                break;
+                if(ref.mAssociation)
+                    {
+                    referenced = true;
+                    }
+                // Only defined classes and operations in the parsed
+                // translation unit have a module.
+                else if(ref.mOperation)
+                    {
+                    referenced = (ref.mOperation->getModule() != nullptr);
+                    }
+                else
+                    {
+                    referenced = (ref.mClassifier->getModule() != nullptr);
+                    }
+                if(referenced)
+                    {
+                    break;
+                    }
                 }
             }
         }
-    // Check relations.
-    if(!referenced)
+    else
         {
-        for(auto &assoc : mAssociations)
+        for(const auto &type : mTypes)
             {
-            if(assoc->getChild() == &checkType || assoc->getParent() == &checkType)
+            if(type->getDataType() == DT_Class)
                 {
-                referenced = true;
-                break;
+                ModelClassifier *classifier = ModelClassifier::getClass(type.get());
+                // Only defined classes in the parsed translation unit have a module.
+                if(classifier->getModule())
+                    {
+                    referenced = isTypeReferencedByClassAttributes(*classifier, checkType);
+                    }
+                if(!referenced)
+                    {
+                    for(auto &oper : classifier->getOperations())
+                        {
+                        referenced = isTypeReferencedByOperation(*oper, checkType);
+                        if(referenced)
+                            {
+                            break;
+                            }
+                        }
+                    }
+                if(referenced)
+                    {
+                    break;
+                    }
+                }
+            }
+        // Check relations.
+        if(!referenced)
+            {
+            for(auto &assoc : mAssociations)
+                {
+                if(assoc->getChild() == &checkType || assoc->getParent() == &checkType)
+                    {
+                    referenced = true;
+                    break;
+                    }
                 }
             }
         }
     return referenced;
     }
 
+void ModelData::getAssociations(ModelClassifier const &classifier,
+        std::vector<ModelAssociation const *> &assocs) const
+    {
+    assocs.clear();
+    if(mTypeReferencesIndexed)
+        {
+        auto const &iter = mTypeReferences.find(&classifier);
+        if(iter != mTypeReferences.end())
+            {
+            for(auto const &ref : (*iter).second)
+                {
+                if(ref.mAssociation)
+                    {
+                    assocs.push_back(ref.mAssociation);
+                    }
+                }
+            }
+        }
+    else
+        {
+        for(auto const &assoc : mAssociations)
+            {
+            if(assoc->getChild() == &classifier || assoc->getParent() == &classifier)
+                {
+                assocs.push_back(assoc.get());
+                }
+            }
+        }
+    }
+
+void ModelData::indexCalls()
+    {
+    mOperationCallers.clear();
+    for(auto const &type : mTypes)
+        {
+        ModelClassifier const *callerCls = ModelClassifier::getClass(type.get());
+        if(callerCls)
+            {
+            for(auto const &oper : callerCls->getOperations())
+                {
+                for(auto const &stmt : oper->getStatements())
+                    {
+                    if(stmt.getStatementType() == ST_Call)
+                        {
+                        ModelClassifier const *calleeCls = ModelClassifier::getClass(
+                            stmt.getClassDecl().getDeclType());
+                        if(calleeCls)
+                            {
+                            auto &callers = mOperationCallers[CalleeKey(calleeCls,
+                                stmt.getFuncName())];
+                            // An operation may call the same operation many times.
+                            if(callers.size() == 0 ||
+                                    callers.back().mOperation != oper.get())
+                                {
+                                callers.push_back(ModelOperationCaller(callerCls,
+                                    oper.get()));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    mCallsIndexed = true;
+    }
+
+void ModelData::getOperationCallers(ModelClassifier const &calleeClass,
+        OovStringRef const calleeOperName,
+        std::vector<ModelOperationCaller> &callers) const
+    {
+    callers.clear();
+    if(mCallsIndexed)
+        {
+        auto const &iter = mOperationCallers.find(CalleeKey(&calleeClass,
+            calleeOperName.getStr()));
+        if(iter != mOperationCallers.end())
+            {
+            callers = (*iter).second;
+            }
+        }
+    else
+        {
+        for(auto const &type : mTypes)
+            {
+            ModelClassifier const *callerCls = ModelClassifier::getClass(type.get());
+            if(callerCls)
+                {
+                for(auto const &oper : callerCls->getOperations())
+                    {
+                    for(auto const &stmt : oper->getStatements())
+                        {
+                        if(stmt.getStatementType() == ST_Call &&
+                            ModelClassifier::getClass(stmt.getClassDecl().getDeclType()) ==
+                                &calleeClass && stmt.operMatch(calleeOperName))
+                            {
+                            callers.push_back(ModelOperationCaller(callerCls,
+                                oper.get()));
+                            break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+void ModelData::getUsedTypes(ModelType const &userType,
+        std::vector<std::pair<ModelType const *, eModelTypeUserKinds>> &usedTypes) const
+    {
+    usedTypes.clear();
+    if(userType.isTemplateUseType())
+        {
+        ConstModelClassifierVector relatedClassifiers;
+        getRelatedTypeArgClasses(userType, relatedClassifiers);
+        for(auto const &rc : relatedClassifiers)
+            {
+            usedTypes.push_back(std::make_pair(rc, MTU_TemplateArg));
+            }
+        }
+    ModelClassifier const *cl = ModelClassifier::getClass(&userType);
+    if(cl)
+        {
+        for(auto const &attr : cl->getAttributes())
+            {
+            usedTypes.push_back(std::make_pair(attr->getDeclType(), MTU_Member));
+            }
+        ConstModelClassifierVector relatedClasses;
+        getRelatedFuncInterfaceClasses(*cl, relatedClasses);
+        for(auto const &cls : relatedClasses)
+            {
+            usedTypes.push_back(std::make_pair(cls, MTU_FuncParam));
+            }
+        ConstModelDeclClasses relatedDeclClasses;
+        getRelatedBodyVarClasses(*cl, relatedDeclClasses);
+        for(auto const &rdc : relatedDeclClasses)
+            {
+            usedTypes.push_back(std::make_pair(rdc.getClass(), MTU_FuncBodyVar));
+            }
+        }
+    }
+
+void ModelData::indexTypeUsers()
+    {
+    mTypeUsers.clear();
+    std::vector<std::pair<ModelType const *, eModelTypeUserKinds>> usedTypes;
+    for(auto const &type : mTypes)
+        {
+        getUsedTypes(*type, usedTypes);
+        for(auto const &used : usedTypes)
+            {
+            if(used.first)
+                {
+                ModelTypeUser user(type.get(), used.second);
+                auto &users = mTypeUsers[used.first];
+                // A class may have many members of the same type.
+                if(users.size() == 0 || !(users.back() == user))
+                    {
+                    users.push_back(user);
+                    }
+                }
+            }
+        }
+    mTypeUsersIndexed = true;
+    }
+
+void ModelData::getTypeUsers(ModelType const &type,
+        std::vector<ModelTypeUser> &users) const
+    {
+    users.clear();
+    if(mTypeUsersIndexed)
+        {
+        auto const &iter = mTypeUsers.find(&type);
+        if(iter != mTypeUsers.end())
+            {
+            users = (*iter).second;
+            }
+        }
+    else
+        {
+        std::vector<std::pair<ModelType const *, eModelTypeUserKinds>> usedTypes;
+        for(auto const &userType : mTypes)
+            {
+            getUsedTypes(*userType, usedTypes);
+            for(auto const &used : usedTypes)
+                {
+                if(used.first == &type)
+                    {
+                    ModelTypeUser user(userType.get(), used.second);
+                    if(users.size() == 0 || !(users.back() == user))
+                        {
+                        users.push_back(user);
+                        }
+                    }
+                }
+            }
+        }
+    }
@@ -10,97 +10,88 @@
 
 #include "ModelObjects.h"
 #include "Debug.h"
-#include <map>
 
 void ModelData::replaceType(ModelType *existingType, ModelClassifier *newType)
     {
-    // Don't need to update function parameter types at this time, because the
-    // existing type is a datatype, and datatypes are not referred to at this time.
-
-    // update member attributes.
-    for(const auto &type : mTypes)
+    if(mTypeReferencesIndexed)
         {
-        if(type->getDataType() == DT_Class)
+        auto iter = mTypeReferences.find(existingType);
+        if(iter != mTypeReferences.end())
             {
-            ModelClassifier *classifier = ModelClassifier::getClass(type.get());
-            for(auto &attr : classifier->getAttributes())
+            // References to elements stay valid if the map is rehashed.
+            std::vector<ModelTypeReference> &existingRefs = (*iter).second;
+            std::vector<ModelTypeReference> &newRefs = mTypeReferences[newType];
+            for(auto &ref : existingRefs)
                 {
-                if(attr->getDeclType() == existingType)
+                if(ref.mTypeRef)
                     {
-                    attr->setDeclType(newType);
+                    ref.mTypeRef->setDeclType(newType);
                     }
-                }
-            for(auto &oper : classifier->getOperations())
-                {
-                for(auto &parm : oper->getParams())
+                else
                     {
-                    if(parm->getDeclType() == existingType)
+                    if(ref.mAssociation->getChild() == existingType)
                         {
-                        parm->setDeclType(newType);
+                        ref.mAssociation->setChildClass(newType);
                         }
-                    }
-                for(auto &vd : oper->getBodyVarDeclarators())
-                    {
-                    if(vd->getDeclType() == existingType)
+                    if(ref.mAssociation->getParent() == existingType)
                         {
-                        vd->setDeclType(newType);
+                        ref.mAssociation->setParentClass(newType);
                         }
                     }
-                if(oper->getReturnType().getDeclType() == existingType)
-                    {
-                    oper->getReturnType().setDeclType(newType);
-                    }
-                replaceStatementType(oper->getStatements(), existingType, newType);
+                newRefs.push_back(ref);
                 }
+            // The iterator may not be valid after adding the new type.
+            mTypeReferences.erase(existingType);
             }
+        removeType(existingType);
         }
-    // Resolve relations.
-    for(auto &assoc : mAssociations)
+    else
         {
-        if(assoc->getChild() == existingType)
+        // The associations are used while parsing to find base classes, so
+        // they must be updated now.
+        for(auto &assoc : mAssociations)
             {
-            assoc->setChildClass(newType);
-            }
-        if(assoc->getParent() == existingType)
-            {
-            assoc->setParentClass(newType);
+            if(assoc->getChild() == existingType)
+                {
+                assoc->setChildClass(newType);
+                }
+            if(assoc->getParent() == existingType)
+                {
+                assoc->setParentClass(newType);
+                }
             }
+        // Other references are updated when the references are indexed.
+        mTypeReplacements[existingType] = newType;
+        mReplacedTypes.push_back(removeType(existingType));
         }
-    eraseType(existingType);
     }
 
-void ModelData::replaceStatementType(ModelStatements &stmts, ModelType *existingType,
-        ModelClassifier *newType)
+std::unique_ptr<ModelType> ModelData::removeType(ModelType *existingType)
     {
-    for(auto &stmt : stmts)
+    std::unique_ptr<ModelType> removedType;
+    auto indexIter = mTypeNameIndex.find(existingType->getName().getStr());
+    if(indexIter != mTypeNameIndex.end() && (*indexIter).second == existingType)
         {
-        if(stmt.getStatementType() == ST_Call ||
-                stmt.getStatementType() == ST_VarRef)
+        mTypeNameIndex.erase(indexIter);
+        // If there is another type with the same name, it can now be found.
+        for(auto const &type : mTypes)
             {
-            if(stmt.getClassDecl().getDeclType() == existingType)
-                {
-                stmt.getClassDecl().setDeclType(newType);
-                }
-            if(stmt.getStatementType() == ST_VarRef)
+            if(type.get() != existingType && type->getName() == existingType->getName())
                 {
-                if(stmt.getVarDecl().getDeclType() == existingType)
-                    {
-                    stmt.getVarDecl().setDeclType(newType);
-                    }
+                mTypeNameIndex.insert(std::make_pair(type->getName().getStr(), type.get()));
+                break;
                 }
             }
         }
-    }
-
-void ModelData::eraseType(ModelType *existingType)
-    {
-    // Delete the old type
     for(size_t ci=0; ci<mTypes.size(); ci++)
         {
         if(mTypes[ci].get() == existingType)
             {
+            removedType = std::move(mTypes[ci]);
             mTypes.erase(mTypes.begin() +
                 static_cast<int>(ci));
+            break;
             }
         }
+    return removedType;
     }
@@ -186,7 +186,8 @@ bool OovPipeProcessLinux::linuxCreatePipeProcess(OovStringRef const procPath,
     return success;
     }
 
-void OovPipeProcessLinux::linuxChildProcessListen(OovProcessListener &listener, int &exitCode)
+bool OovPipeProcessLinux::linuxChildProcessListen(OovProcessListener &listener, int &exitCode,
+    OovTaskContinueListener const *contListener)
     {
 //    write(mOutPipes[P_Write], "\n", 1); // Write to child's stdin
     struct pollfd rfds[2];
@@ -203,6 +204,10 @@ void OovPipeProcessLinux::linuxChildProcessListen(OovProcessListener &listener,
     siginfo_t siginfo;
     while((pidStat = waitid(P_PID, mChildProcessId, &siginfo, WEXITED | WNOHANG)) != -1)
         {
+        if(contListener && !contListener->continueProcessingItem())
+            {
+            return true;
+            }
 #if(DEBUG_PROC)
         sDbgFile.printflush("linuxChildProcessListen pidstat %d\n", pidStat);
         // 17 0 1 means exited.
@@ -286,9 +291,12 @@ void OovPipeProcessLinux::linuxChildProcessListen(OovProcessListener &listener,
         }
     else
         exitCode = waitStatus;
+    // The child has exited, so there is no need to kill it later.
+    mChildProcessId = 0;
 #if(DEBUG_PROC)
     sDbgFile.printflush("linuxChildProcessListen - done\n");
 #endif
+    return false;
     }
 
 void OovPipeProcessLinux::linuxChildProcessSend(OovStringRef const str)
@@ -492,7 +500,8 @@ bool OovPipeProcessWindows::windowsCreatePipeProcess(OovStringRef const procPath
     return success;
     }
 
-void OovPipeProcessWindows::windowsChildProcessListen(OovProcessListener &listener, int &exitCode)
+bool OovPipeProcessWindows::windowsChildProcessListen(OovProcessListener &listener, int &exitCode,
+    OovTaskContinueListener const *contListener)
     {
     exitCode = -1;
     bool exit = false;
@@ -500,6 +509,10 @@ void OovPipeProcessWindows::windowsChildProcessListen(OovProcessListener &listen
     bool gotData2 = false;
     while(!exit)
         {
+        if(contListener && !contListener->continueProcessingItem())
+            {
+            return true;
+            }
         DWORD dwExitCode;
         if(GetExitCodeProcess(mProcInfo.hProcess, &dwExitCode))
             {
@@ -524,6 +537,7 @@ void OovPipeProcessWindows::windowsChildProcessListen(OovProcessListener &listen
         if(!gotData1 && !gotData2)
             sleepMs(10);
         }
+    return false;
     }
 
 void OovPipeProcessWindows::windowsChildProcessClose()
@@ -601,6 +615,23 @@ void OovPipeProcess::childProcessListen(OovProcessListener &listener, int &exitC
     listener.processComplete();
     }
 
+bool OovPipeProcess::childProcessListenUntil(OovProcessListener &listener,
+        OovTaskContinueListener const &contListener, int &exitCode)
+    {
+#ifdef __linux__
+    bool running = mPipeProcLinux.linuxChildProcessListen(listener, exitCode,
+        &contListener);
+#else
+    bool running = mPipeProcWindows.windowsChildProcessListen(listener, exitCode,
+        &contListener);
+#endif
+    if(!running)
+        {
+        listener.processComplete();
+        }
+    return running;
+    }
+
 void OovPipeProcess::childProcessSend(OovStringRef const str)
     {
 #ifdef __linux__
@@ -229,7 +229,10 @@ class OovPipeProcessLinux
         bool linuxCreatePipes();
         bool linuxCreatePipeProcess(OovStringRef const procPath,
                 char const * const *argv, char const *workingDir);
-        void linuxChildProcessListen(OovProcessListener &listener, int &exitCode);
+        /// Returns true if the continue listener stopped listening while
+        /// the child process is still running.
+        bool linuxChildProcessListen(OovProcessListener &listener, int &exitCode,
+                OovTaskContinueListener const *contListener=nullptr);
         void linuxChildProcessKill();
         void linuxChildProcessSend(OovStringRef const str);
     private:
@@ -254,7 +257,10 @@ class OovPipeProcessWindows
             }
         bool windowsCreatePipeProcess(OovStringRef const procPath,
                 char const * const *argv, bool showWindows, char const *workingDir);
-        void windowsChildProcessListen(OovProcessListener &listener, int &exitCode);
+        /// Returns true if the continue listener stopped listening while
+        /// the child process is still running.
+        bool windowsChildProcessListen(OovProcessListener &listener, int &exitCode,
+                OovTaskContinueListener const *contListener=nullptr);
         void windowsChildProcessClose();
         bool windowsChildProcessSend(OovStringRef const str);
         void windowsChildProcessKill();
@@ -299,6 +305,16 @@ class OovPipeProcess
         ///     is received
         /// @param exitCode The exit code of the child process
         void childProcessListen(OovProcessListener &listener, int &exitCode);
+        /// This is the same as childProcessListen, except that it also stops
+        /// listening when the continue listener returns false. This allows
+        /// a child process to be sent many requests.
+        /// @param listener The listener that will be called when pipe data
+        ///     is received
+        /// @param contListener Indicates when all expected output is received.
+        /// @param exitCode The exit code of the child process if it exited.
+        /// Returns true if the child process is still running.
+        bool childProcessListenUntil(OovProcessListener &listener,
+                OovTaskContinueListener const &contListener, int &exitCode);
         /// Sends some data to the standard in of the child process
         /// @param str The data to send to the child
         void childProcessSend(OovStringRef const str);
@@ -325,6 +325,8 @@ void GuiOptions::setDefaultOptions()
     setNameValueBool(OptGuiShowRelationKey, true);
 
     setNameValueBool(OptGuiShowCompImplicitRelations, false);
+    setNameValueBool(OptGuiLayeredDependencyLayout, false);
+    setNameValueBool(OptGuiForceClassLayout, false);
     /*
     #ifdef __linux__
         setNameValue(OptEditorPath, "/usr/bin/gedit");
@@ -28,6 +28,12 @@
 #define OptGuiShowRelationKey "ShowRelationKey"
 
 #define OptGuiShowCompImplicitRelations "ShowCompImplicitRelations"
+/// Use the layered layout instead of the genetic layout for include and
+/// portion diagrams.
+#define OptGuiLayeredDependencyLayout "LayeredDependencyLayout"
+/// Use the force directed layout instead of the genetic layout for class
+/// diagrams.
+#define OptGuiForceClassLayout "ForceClassLayout"
 
 #define OptGuiFontSize "FontSize"
 
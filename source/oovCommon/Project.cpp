@@ -60,6 +60,27 @@ OovString Project::getBuildPackagesFilePath()
     return fn;
     }
 
+OovString Project::getBuildDurationsFilePath()
+    {
+    FilePath fn(Project::getProjectDirectory(), FP_Dir);
+    fn.appendFile("oovaide-durations.txt");
+    return fn;
+    }
+
+OovString Project::getAnalysisDurationsFilePath()
+    {
+    FilePath fn(Project::getProjectDirectory(), FP_Dir);
+    fn.appendFile("oovaide-analysis-durations.txt");
+    return fn;
+    }
+
+OovString Project::getBuildTraceFilePath()
+    {
+    FilePath fn(Project::getProjectDirectory(), FP_Dir);
+    fn.appendFile("oovaide-trace.json");
+    return fn;
+    }
+
 OovStringRef const Project::getSrcRootDirectory()
     {
     if(sSourceRootDirectory.length() == 0)
@@ -277,6 +298,13 @@ FilePath Project::getOutputDir()
     return fp;
     }
 
+FilePath Project::getCompileCacheDir()
+    {
+    FilePath fp(Project::getProjectDirectory(), FP_Dir);
+    fp.appendDir("oovaide-objcache");
+    return fp;
+    }
+
 FilePath Project::getBuildOutputDir(OovStringRef const buildDirClass)
     {
     return getDir("out-", buildDirClass, getProjectDirectory());
@@ -495,6 +523,14 @@ void ProjectBuildArgs::parseArgs(OovStringVec const &args)
             {
             mVerbose = true;
             }
+        else if(arg.find("-bc", 0, 3) == 0)
+            {
+            mCompileCache = true;
+            }
+        else if(arg.find("-bt", 0, 3) == 0)
+            {
+            mBuildTrace = true;
+            }
         else if(arg.find("-lnk", 0, 4) == 0)
             {
             addLinkArg(linkOrderIndex++, arg.substr(4));
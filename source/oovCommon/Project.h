@@ -55,6 +55,17 @@
 #define DupsDir "dups"
 #define DupsHashExtension "hsh"
 
+// The oovCppParser server mode reads requests from stdin. Each request is a
+// line with the number of arguments, followed by each argument terminated by
+// a newline. Arguments can be empty, but cannot contain a newline or carriage
+// return. A request with zero arguments stops the server. The result of each
+// request is a line on stdout that starts with the result string followed by
+// the exit code. After all error output for the request, a line with the
+// error end string is written to stderr.
+#define CppParserServerArg "-server"
+#define CppParserServerResult "oovCppParser-result: "
+#define CppParserServerErrEnd "oovCppParser-end"
+
 
 enum eProcessModes
     {
@@ -116,12 +127,23 @@ class Project
 
         static OovString getPackagesFilePath();
         static OovString getBuildPackagesFilePath();
+        /// The durations of the build processes.
+        static OovString getBuildDurationsFilePath();
+        /// The durations of the analysis processes. These are kept separate
+        /// from the build durations so that the average of unknown files is
+        /// only of the same kind of process.
+        static OovString getAnalysisDurationsFilePath();
+        /// The trace event timeline of the analysis and build.
+        static OovString getBuildTraceFilePath();
 
         /// buildDirClass = BuildConfigAnalysis, BuildConfigDebug, etc.
         static FilePath getBuildOutputDir(OovStringRef const buildDirClass);
         static FilePath getIntermediateDir(OovStringRef const buildDirClass);
 
         static FilePath getOutputDir();
+        /// This is shared by all build configurations and is not removed
+        /// by cleaning the build.
+        static FilePath getCompileCacheDir();
 
         static OovStringRef const getSrcRootDirectory();
         /// Returns a filename relative to the root source directory.
@@ -136,6 +158,11 @@ class Project
 
         static OovStringRef getAnalysisIncDepsFilename()
             { return "oovaide-incdeps.txt"; }
+        /// The parsers write the include dependencies for each source file
+        /// into a separate file in this directory of the analysis directory.
+        /// These are merged into the include dependency file after analysis.
+        static OovStringRef getAnalysisIncDepsFragmentDirName()
+            { return "incdeps"; }
         /// Make a filename for the compressed content file for each source file.
         /// The analysisDir is retreived from the build configuration.
         static OovString makeAnalysisFileName(OovStringRef const srcFileName,
@@ -205,7 +232,8 @@ class ProjectBuildArgs
     public:
         ProjectBuildArgs(ProjectReader &project):
             mProjectOptions(project), mBuildEnv(project),
-            mProjectPackages(false), mBuildPackages(false), mVerbose(false)
+            mProjectPackages(false), mBuildPackages(false), mVerbose(false),
+            mCompileCache(false), mBuildTrace(false)
             {}
         void setBuildConfig(OovStringRef buildMode, OovStringRef const buildConfig);
         // This must set the component name as from ComponentTypesFile
@@ -260,6 +288,13 @@ class ProjectBuildArgs
             { return mBuildEnv; }
         bool getVerbose() const
             { return mVerbose; }
+        /// True if compiled object files should be reused from the
+        /// compile cache directory.
+        bool getCompileCache() const
+            { return mCompileCache; }
+        /// True if a timeline of the build should be saved.
+        bool getBuildTrace() const
+            { return mBuildTrace; }
 
     private:
         ProjectReader &mProjectOptions;
@@ -282,6 +317,8 @@ class ProjectBuildArgs
         /// external root directories.
         BuildPackages mBuildPackages;
         bool mVerbose;
+        bool mCompileCache;
+        bool mBuildTrace;
 
         void addCompileArg(OovStringRef const str)
             { mCompileArgs.push_back(str); }
@@ -136,6 +136,8 @@ class CrashDiagnostics
             { mEnableDumpCursor = enable; }
         void setCrashed()
             { mCrashed = true; }
+        void clearCrashed()
+            { mCrashed = false; }
         bool hasCrashed() const
             { return mCrashed; }
         void dumpCrashed(FILE *fp)
@@ -1296,19 +1298,19 @@ static ModelModuleLineStats makeLineStats(CXCursor cursor)
     }
 #endif
 
-CppParser::eErrorTypes CppParser::parse(bool lineHashes, char const * const srcFn,
+CppParser::eErrorTypes CppParser::parse(CXIndex index, bool lineHashes,
+        char const * const srcFn,
         char const * const srcRootDir, char const * const outDir,
         char const * const clang_args[], int num_clang_args)
     {
     eErrorTypes errType = ET_None;
 
+    sCrashDiagnostics.clearCrashed();
     mTopParseFn.setPath(srcFn, FP_File);
     /// Create a module so the modelwriter has a filename.
     mParserModelData.addParsedModule(srcFn);
 
-    mIncDirDeps.read(outDir, Project::getAnalysisIncDepsFilename());
-
-    CXIndex index = clang_createIndex(1, 1);
+    mIncDirDeps.setFragmentFilename(srcFn, srcRootDir, outDir);
 
     std::string outBaseFileName = Project::makeOutBaseFileName(srcFn,
             srcRootDir, outDir);
@@ -1447,6 +1449,7 @@ CppParser::eErrorTypes CppParser::parse(bool lineHashes, char const * const srcF
             {
             unlink(outErrFileName.c_str());
             }
+        clang_disposeTranslationUnit(tu);
         }
     else
         {
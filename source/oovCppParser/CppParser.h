@@ -137,7 +137,9 @@ class CppParser
         enum eErrorTypes { ET_None, ET_CompileWarnings, ET_CompileErrors,
             ET_CLangError, ET_ParseError };
         /// Parses a C++ source file.
-        eErrorTypes parse(bool lineHashes, char const * const srcFn, char const * const srcRootDir,
+        /// @param index The index can be reused for parsing many files.
+        eErrorTypes parse(CXIndex index, bool lineHashes,
+                char const * const srcFn, char const * const srcRootDir,
                 char const * const outDir,
                 char const * const clang_args[], int num_clang_args);
         /// These are public for access by global functions callbacks.
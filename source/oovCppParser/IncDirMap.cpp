@@ -7,151 +7,74 @@
 
 #include "IncDirMap.h"
 #include "IncludeMap.h"
+#include "Project.h"
 #include "OovError.h"
 #include <algorithm>            // For find
 #include <time.h>
 #include <limits.h>     // For UINT_MAX
 
 
-#define SHARED_FILE 1
-
-void IncDirDependencyMap::read(char const * const outDir, char const * const incFn)
+void IncDirDependencyMap::setFragmentFilename(char const * const srcFn,
+        char const * const srcRootDir, char const * const outDir)
     {
-    FilePath outIncFileName(outDir, FP_Dir);
-    outIncFileName.appendFile(incFn);
-    setFilename(outIncFileName);
-#if(SHARED_FILE)
-    OovStatus status = readFileShared();
-    if(status.needReport())
-        {
-        status.report(ET_Error, "\nOovCppParser - Read file sharing error\n");
-        }
-#else
-    if(!readFile())
-        {
-        }
-#endif
+    FilePath fragmentDir(outDir, FP_Dir);
+    fragmentDir.appendDir(Project::getAnalysisIncDepsFragmentDirName());
+    OovString fragmentFn = Project::makeOutBaseFileName(srcFn, srcRootDir,
+        fragmentDir);
+    fragmentFn += ".txt";
+    setFilename(fragmentFn);
     }
 
 /// For every includer file that is run across during parsing, this means that
 /// the includer file was fully parsed, and that no old included information
-/// needs to be kept, except to check if the old included information has not
-/// changed.
+/// needs to be kept. The merger checks if the included information has
+/// changed from the previous analysis.
 ///
 ///  This code assumes that no tricks are played with ifdef values, and
 /// ifdef values must be the same every time a the same file is included.
 void IncDirDependencyMap::write()
     {
-    bool anyChanges = false;
     time_t curTime;
-    time_t changedTime = 0;
     time(&curTime);
 
-#if(SHARED_FILE)
-    SharedFile file;
-    OovStatus status = writeFileExclusiveReadUpdate(file);
-    if(status.needReport())
-        {
-        OovString err = "\nOovCppParser - Write file sharing error ";
-        err += getFilename().c_str();
-        err += "\n";
-        status.report(ET_Error, err);
-        }
-#endif
-    // Append new values from parsed includes into the original NameValueFile.
-    // Update existing values times and make new dependencies.
     for(const auto &newMapItem : mParsedIncludeDependencies)
         {
-        bool changed = includedPathsChanged(newMapItem.first, newMapItem.second);
-        if(changed)
-            {
-            // Cheat and say updated time and checked time are the same.
-            changedTime = curTime;
-
-            CompoundValue newIncludedInfoCompVal;
-            OovString changeStr;
-            changeStr.appendInt(changedTime);
-            newIncludedInfoCompVal.addArg(changeStr);
+        // Cheat and say updated time and checked time are the same.
+        CompoundValue newIncludedInfoCompVal;
+        OovString changeStr;
+        changeStr.appendInt(curTime);
+        newIncludedInfoCompVal.addArg(changeStr);
 
-            OovString checkedStr;
-            checkedStr.appendInt(curTime);
-            newIncludedInfoCompVal.addArg(checkedStr);
+        OovString checkedStr;
+        checkedStr.appendInt(curTime);
+        newIncludedInfoCompVal.addArg(checkedStr);
 
-            for(const auto &str : newMapItem.second)
+        for(const auto &str : newMapItem.second)
+            {
+            size_t pos = newIncludedInfoCompVal.find(str);
+            if(pos == CompoundValue::npos)
                 {
-                size_t pos = newIncludedInfoCompVal.find(str);
-                if(pos == CompoundValue::npos)
-                    {
-                    newIncludedInfoCompVal.addArg(str);
-                    }
+                newIncludedInfoCompVal.addArg(str);
                 }
-            setNameValue(newMapItem.first, newIncludedInfoCompVal.getAsString());
-            anyChanges = true;
-            }
-        }
-    if(file.isOpen() && anyChanges)
-        {
-#if(SHARED_FILE)
-        OovStatus status = writeFileExclusive(file);
-        if(!status.ok())
-            {
-            status.report(ET_Error, "Unable to write include map file");
             }
-#else
-        writeFile();
-#endif
+        setNameValue(newMapItem.first, newIncludedInfoCompVal.getAsString());
         }
-    }
-
-bool IncDirDependencyMap::includedPathsChanged(OovStringRef includerFn,
-        std::set<std::string> const &includedInfoStr) const
-    {
-    bool changed = false;
-
-    // First check if the includer filename exists in the dependency file.
-    OovString origIncludedInfoStr = getValue(includerFn);
-    if(origIncludedInfoStr.size() > 0)
+    FilePath fragmentDir(getFilename(), FP_File);
+    fragmentDir.discardFilename();
+    OovStatus status = FileEnsurePathExists(fragmentDir);
+    if(status.ok())
         {
-        CompoundValue origIncludedInfoCompVal;
-        // get the changed time, which is the first value and discard
-        // everything else.
-        origIncludedInfoCompVal.parseString(origIncludedInfoStr);
-        // Check that counts of the number of includes is the same in
-        // the new and original map.  This will detect deleted includes.
-        if(origIncludedInfoCompVal.size()-IncDirMapNumTimeVals !=
-                (includedInfoStr.size() * IncDirMapNumIncPathParts))
-            {
-            changed = true;
-            }
-        else
-            {
-            // Every included file in the new map must exist in the
-            // original map.
-            for(const auto &included : includedInfoStr)
-                {
-                CompoundValue incPathParts;
-                incPathParts.parseString(included);
-                if(incPathParts.size() == 2)
-                    {
-                    if(std::find(origIncludedInfoCompVal.begin(),
-                            origIncludedInfoCompVal.end(), incPathParts[1]) ==
-                            origIncludedInfoCompVal.end())
-                        {
-                        changed = true;
-                        }
-                    }
-                else
-                    {
-                    changed = true;
-                    }
-                }
-            }
+        // Each parsed source file has a separate fragment file, so no
+        // locking is needed.
+        status = writeFile();
         }
-    else
+    if(status.needReport())
         {
-        changed = true;
+        OovString err = "\nOovCppParser - Unable to write include map fragment ";
+        err += getFilename().c_str();
+        err += "\n";
+        status.report(ET_Error, err);
         }
-    return changed;
     }
 
 void IncDirDependencyMap::insert(const std::string &includerFn,
@@ -14,15 +14,19 @@
 #include <string>
 
 /// This works to build include paths, and to build include file dependencies
-/// This makes a file that keeps a map of paths, and for each path:
-///     the last time the path dependencies were updated by the parser,
+/// This makes a fragment file for a parsed source file that keeps a map of
+/// paths, and for each path:
+///     the time that the path dependencies were parsed,
 ///     the last time the paths were checked - THIS IS NOT UPDATED!,
 ///     the included filepath (such as "gtk/gtk.h"), and the search path
 ///     to get to that file.
+/// The fragment files are merged by the IncDirDependencyMapMerger.
 class IncDirDependencyMap:public NameValueFile
     {
     public:
-        void read(char const * const outDir, char const * const incPath);
+        /// Sets the name of the fragment file for the parsed source file.
+        void setFragmentFilename(char const * const srcFn,
+                char const * const srcRootDir, char const * const outDir);
         void write();
         void insert(const std::string &includerPath, const FilePath &includedPath);
 
@@ -32,8 +36,6 @@ class IncDirDependencyMap:public NameValueFile
         /// The second string is a compound value containing the IncludedPath,
         /// which contains the included filepath, and the search path.
         std::map<std::string, std::set<std::string>> mParsedIncludeDependencies;
-        bool includedPathsChanged(OovStringRef includerFn,
-                std::set<std::string> const &includedInfoStr) const;
     };
 
 
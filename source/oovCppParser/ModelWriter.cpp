@@ -105,13 +105,10 @@ static int newModelId()
 int ModelWriter::getObjectModelId(const std::string &name)
     {
     int index = -1;
-    for(size_t i=0; i<mModelData.mTypes.size(); i++)
+    auto const iter = mTypeModelIds.find(name);
+    if(iter != mTypeModelIds.end())
         {
-        if(name.compare(mModelData.mTypes[i]->getName()) == 0)
-            {
-            index = static_cast<int>(i) + MIO_Object;
-            break;
-            }
+        index = (*iter).second;
         }
     return index;
     }
@@ -472,6 +469,16 @@ OovStatusReturn ModelWriter::writeAssociation(const ModelAssociation &assoc)
 OovStatusReturn ModelWriter::writeFile(OovStringRef const filename)
     {
     OovStatus status = openFile(filename);
+    // The server mode writes many files from one process, so each file
+    // must start with the same ids.
+    sModelId = MIO_NoLookup;
+    mTypeModelIds.clear();
+    for(size_t i=0; i<mModelData.mTypes.size(); i++)
+        {
+        // If there are types with the same name, the first one is used.
+        mTypeModelIds.insert(std::make_pair(mModelData.mTypes[i]->getName(),
+            static_cast<int>(i) + MIO_Object));
+        }
     if(status.ok())
         {
         int moduleXmiId=MIO_Module;
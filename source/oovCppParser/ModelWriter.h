@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include "ModelObjects.h"
 #include "File.h"
+#include <unordered_map>
 
 
 /**
@@ -43,6 +44,8 @@ public:
 private:
     File mFile;
     const ModelData &mModelData;
+    /// The key is the type name, and the value is the model id of the type.
+    std::unordered_map<std::string, int> mTypeModelIds;
 
     OovStatusReturn openFile(OovStringRef const filename);
     int getObjectModelId(const std::string &name);
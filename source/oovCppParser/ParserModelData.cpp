@@ -211,6 +211,8 @@ void ParserModelData::setLineStats(ModelModuleLineStats const &lineStats)
 
 void ParserModelData::writeModel(OovStringRef fileName)
     {
+    // This also updates the references to types that were upgraded to classes.
+    mModelData.indexTypeReferences();
     ModelWriter writer(mModelData);
     OovStatus status = writer.writeFile(fileName);
     if(status.needReport())
@@ -12,53 +12,129 @@
 #include "CppParser.h"
 #include "Version.h"
 #include "OovProcessArgs.h"
+#include "Project.h"
 #include <stdlib.h>     /* exit, EXIT_FAILURE */
 #include <stdio.h>
 #include <string.h>
+#include <memory>
+#include <iostream>
 
 
-static CppParser sCppParser;
+/// Parses a single source file.
+/// @param argv The first argument is the source file path, followed by
+///     the source root directory, the output directory, and then the
+///     compiler arguments.
+static int parseFile(CXIndex index, int argc, char const *const argv[])
+    {
+    bool dupHashes = false;
+    OovProcessChildArgs childArgs;
+    for(int i=3; i<argc; i++)
+        {
+        if(strcmp(argv[i], "-dups") == 0)
+            {
+            dupHashes = true;
+            }
+        else
+            {
+            childArgs.addArg(argv[i]);
+            }
+        }
+    // The parser keeps state for the translation unit, so a new one is
+    // used for every file.
+    std::unique_ptr<CppParser> cppParser(new CppParser());
+    // This saves the CPP info in an XMI file.
+    CppParser::eErrorTypes et = cppParser->parse(index, dupHashes,
+        argv[0], argv[1], argv[2],
+        childArgs.getArgv(), static_cast<int>(childArgs.getArgc()));
+    if(et == CppParser::ET_CLangError)
+        {
+        fprintf(stderr, "oovCppParser: CLang error analyzing file %s.\n"
+                "It could be an argument error (Windows spaces in path), or a bug in CLang\n", argv[0]);
+        }
+    else if(et != CppParser::ET_None && et != CppParser::ET_CompileWarnings)
+        {
+        fprintf(stderr, "oovCppParser: Error analyzing file %s\n", argv[0]);
+        }
+    int exitCode = 0;
+    if(et != CppParser::ET_None && et != CppParser::ET_CompileWarnings)
+        exitCode = EXIT_FAILURE;
+    return exitCode;
+    }
 
-int main(int argc, char const *const argv[])
+/// Reads a request line from stdin, and removes any trailing carriage return.
+static bool readRequestLine(std::string &line)
     {
-    CppParser::eErrorTypes et = CppParser::ET_None;
-    OovError::setComponent(EC_OovCppParser);
-    if(argc >= 4)
+    bool success = static_cast<bool>(std::getline(std::cin, line));
+    if(success && line.length() > 0 && line.back() == '\r')
         {
-        bool dupHashes = false;
-        OovProcessChildArgs childArgs;
-        for(int i=4; i<argc; i++)
+        line.pop_back();
+        }
+    return success;
+    }
+
+/// Reads requests from stdin and parses each file. This prevents
+/// starting a process and creating an index for every file.
+/// See CppParserServerArg for the format of the requests.
+static void serveRequests(CXIndex index)
+    {
+    std::string line;
+    while(readRequestLine(line))
+        {
+        size_t numArgs = strtoul(line.c_str(), nullptr, 10);
+        if(numArgs == 0)
+            {
+            break;
+            }
+        OovStringVec args;
+        while(args.size() < numArgs && readRequestLine(line))
+            {
+            args.push_back(line);
+            }
+        if(args.size() < numArgs)
             {
-            if(strcmp(argv[i], "-dups") == 0)
-                {
-                dupHashes = true;
-                }
-            else
-                {
-                childArgs.addArg(argv[i]);
-                }
+            break;
             }
-        // This saves the CPP info in an XMI file.
-//      et = sCppParser.parse(dupHashes, argv[1], argv[2], argv[3], &argv[4], argc-4);
-        et = sCppParser.parse(dupHashes, argv[1], argv[2], argv[3],
-            childArgs.getArgv(), static_cast<int>(childArgs.getArgc()));
-        if(et == CppParser::ET_CLangError)
+        std::vector<char const *> argv;
+        for(auto const &arg : args)
             {
-            fprintf(stderr, "oovCppParser: CLang error analyzing file %s.\n"
-                    "It could be an argument error (Windows spaces in path), or a bug in CLang\n", argv[1]);
+            argv.push_back(arg.getStr());
             }
-        else if(et != CppParser::ET_None && et != CppParser::ET_CompileWarnings)
+        int exitCode = EXIT_FAILURE;
+        if(argv.size() >= 3)
             {
-            fprintf(stderr, "oovCppParser: Error analyzing file %s\n", argv[1]);
+            exitCode = parseFile(index, static_cast<int>(argv.size()), &argv[0]);
             }
+        // The end of the error output is marked so that the error output is
+        // not attributed to the next file.
+        fprintf(stderr, "\n%s\n", CppParserServerErrEnd);
+        fflush(stderr);
+        fprintf(stdout, "\n%s%d\n", CppParserServerResult, exitCode);
+        fflush(stdout);
+        }
+    }
+
+int main(int argc, char const *const argv[])
+    {
+    int exitCode = 0;
+    OovError::setComponent(EC_OovCppParser);
+    if(argc == 2 && strcmp(argv[1], CppParserServerArg) == 0)
+        {
+        CXIndex index = clang_createIndex(1, 1);
+        serveRequests(index);
+        clang_disposeIndex(index);
+        }
+    else if(argc >= 4)
+        {
+        CXIndex index = clang_createIndex(1, 1);
+        exitCode = parseFile(index, argc-1, &argv[1]);
+        clang_disposeIndex(index);
         }
     else
         {
         fprintf(stderr, "OovCppParser version %s\n", OOV_VERSION);
         fprintf(stderr, "oovCppParser args are: sourceFilePath sourceRootDir outputProjectFilesDir [cppArgs]...\n");
-        }
-    int exitCode = 0;
-    if(et != CppParser::ET_None && et != CppParser::ET_CompileWarnings)
+        fprintf(stderr, "   or: %s   to read requests from stdin\n", CppParserServerArg);
         exitCode = EXIT_FAILURE;
+        }
     return exitCode;
     }
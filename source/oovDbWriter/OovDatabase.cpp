@@ -149,6 +149,10 @@ bool OovDatabase::createTables()
             "name VARCHAR NOT NULL"
             ");",
         };
+    mModuleIds.clear();
+    mComponentIds.clear();
+    mTypeIds.clear();
+    mMethodIds.clear();
     bool success = exec("begin");
     if(success)
         {
@@ -165,71 +169,156 @@ bool OovDatabase::createTables()
             success = exec("end");
             }
         }
+    if(success)
+        {
+        success = prepareStatements();
+        }
     return success;
     }
 
-bool OovDatabase::addRecord(OovStringRef colIdName, OovStringRef tableName,
-    OovStringRef srchColName, OovStringRef srchColVal,
-    DbNames insertColNames, DbValues insertColValues, int &retId)
+bool OovDatabase::prepareStatements()
     {
-    bool success = execSelectId(colIdName, tableName, srchColName, srchColVal,
-        false, retId);
-    if(success && retId == UNDEFINED_INT)
+    // These must be in the same order as ePreparedStatements.
+    char const *statementStrs[] =
         {
-        DbString ins;
-        ins.INSERT(tableName).INTO(insertColNames).VALUES(insertColValues);
-        success = exec(ins.getDbStr());
-        if(success)
+        "INSERT INTO Module(name,codeLines,commentLines,moduleLines) "
+            "VALUES(?,?,?,?)",
+        "UPDATE Module SET idOwningComponent=? WHERE idModule=?",
+        "INSERT INTO Component(name) VALUES(?)",
+        "INSERT INTO Type(name,idOwningModule,lineNumber) VALUES(?,?,?)",
+        "INSERT INTO TypeRelation(typeRelationDescription,visibility,"
+            "idSupplierType,idConsumerType) VALUES(?,?,?,?)",
+        "INSERT INTO ModuleRelation(idSupplierModule,idConsumerModule) "
+            "VALUES(?,?)",
+        "INSERT INTO Method(name,lineNumber,visibility,const,virtual,"
+            "idOwningType,idOwningModule) VALUES(?,?,?,?,?,?,?)",
+        "INSERT INTO MethodTypeRef(name,varRelationDescription,"
+            "idOwningMethod,idSupplierType) VALUES(?,?,?,?)",
+        "INSERT INTO Statement(statementDescription,lineNumber,"
+            "idOwningMethod,idSupplierClass,idSupplierMethod) VALUES(?,?,?,?,?)",
+        };
+    static_assert(sizeof(statementStrs)/sizeof(statementStrs[0]) ==
+        PS_NumStatements, "Prepared statements do not match");
+    bool success = true;
+    for(size_t i=0; i<PS_NumStatements && success; i++)
+        {
+        success = mStatements[i].prepare(*this, statementStrs[i]);
+        if(!success)
             {
-            success = execSelectLastInsertedRowId(retId);
+            OovString errStr = statementStrs[i];
+            errStr += " : ";
+            errStr += mSqlError;
+            setLastError(errStr);
             }
         }
     return success;
     }
 
-bool OovDatabase::addName(OovStringRef colIdName, OovStringRef tableName,
-    OovStringRef nameColName, OovStringRef nameValName, int &retId)
+void OovDatabase::closeDatabase()
     {
-    return addRecord(colIdName, tableName, nameColName, nameValName,
-        {colIdName, nameColName}, {nullptr, nameValName.getStr()}, retId);
+    for(auto &stmt : mStatements)
+        {
+        stmt.finalize();
+        }
+    closeDb();
+    }
+
+bool OovDatabase::runStatement(ePreparedStatements ps)
+    {
+    SQLiteStatement &stmt = mStatements[ps];
+    bool success = stmt.step();
+    if(!success)
+        {
+        OovString errStr = stmt.getSql();
+        errStr += " : ";
+        errStr += mSqlError;
+        setLastError(errStr);
+        }
+    return success;
+    }
+
+bool OovDatabase::getMappedId(std::map<OovString, int> const &idMap,
+    OovStringRef table, OovStringRef name, bool failMissing, int &id)
+    {
+    bool success = true;
+    id = UNDEFINED_INT;
+    auto const &iter = idMap.find(name);
+    if(iter != idMap.end())
+        {
+        id = (*iter).second;
+        }
+    else if(failMissing)
+        {
+        OovString str = "Missing id for table ";
+        str += table;
+        str += " name ";
+        str += name;
+        setLastError(str);
+        success = false;
+        }
+    return success;
     }
 
 bool OovDatabase::addComponent(OovStringRef name, int &componentId)
     {
-    return addName("idComponent", "Component", "name", name, componentId);
+    bool success = getMappedId(mComponentIds, "Component", name, false,
+        componentId);
+    if(success && componentId == UNDEFINED_INT)
+        {
+        mStatements[PS_InsertComponent].bindText(1, name);
+        success = runStatement(PS_InsertComponent);
+        if(success)
+            {
+            componentId = getLastInsertRowId();
+            mComponentIds[name] = componentId;
+            }
+        }
+    return success;
     }
 
 bool OovDatabase::updateModuleWithComponent(OovStringRef name, int componentId)
     {
     int moduleId;
     bool success = getModuleId(name, false, moduleId);
-    if(success)
+    if(success && moduleId != UNDEFINED_INT)
         {
-        DbString dbStr;
-        dbStr.UPDATE("Module").SET({"idOwningComponent"},
-                {componentId}).WHERE("idModule", "=", moduleId);
-        success = exec(dbStr.getDbStr());
+        SQLiteStatement &stmt = mStatements[PS_UpdateModuleComponent];
+        stmt.bindInt(1, componentId);
+        stmt.bindInt(2, moduleId);
+        success = runStatement(PS_UpdateModuleComponent);
         }
     return success;
     }
 
 bool OovDatabase::getModuleId(OovStringRef name, bool failMissing, int &moduleId)
     {
-    return execSelectId("idModule", "Module", "name", name, failMissing, moduleId);
+    return getMappedId(mModuleIds, "Module", name, failMissing, moduleId);
     }
 
 bool OovDatabase::addModule(OovStringRef name, int &moduleId, int codeLines,
     int commentLines, int moduleLines)
     {
-    return addRecord("idModule", "Module", "name", name,
-        {"idModule", "name", "codeLines", "commentLines", "moduleLines"},
-        { nullptr, name.getStr(), codeLines, commentLines, moduleLines },
-        moduleId);
+    bool success = getModuleId(name, false, moduleId);
+    if(success && moduleId == UNDEFINED_INT)
+        {
+        SQLiteStatement &stmt = mStatements[PS_InsertModule];
+        stmt.bindText(1, name);
+        stmt.bindInt(2, codeLines);
+        stmt.bindInt(3, commentLines);
+        stmt.bindInt(4, moduleLines);
+        success = runStatement(PS_InsertModule);
+        if(success)
+            {
+            moduleId = getLastInsertRowId();
+            mModuleIds[name] = moduleId;
+            }
+        }
+    return success;
     }
 
 bool OovDatabase::getTypeId(OovStringRef name, bool failMissing, int &typeId)
     {
-    return execSelectId("idType", "Type", "name", name, failMissing, typeId);
+    return getMappedId(mTypeIds, "Type", name, failMissing, typeId);
     }
 
 bool OovDatabase::addType(OovStringRef name, int moduleId, int lineNum,
@@ -238,13 +327,15 @@ bool OovDatabase::addType(OovStringRef name, int moduleId, int lineNum,
     bool success = getTypeId(name, false, typeId);
     if(success && typeId == UNDEFINED_INT)
         {
-        DbString ins;
-        ins.INSERT("Type").INTO({"idType","name","idOwningModule","lineNumber"}).
-                VALUES({nullptr, name.getStr(), moduleId, lineNum});
-        success = exec(ins.getDbStr());
+        SQLiteStatement &stmt = mStatements[PS_InsertType];
+        stmt.bindText(1, name);
+        stmt.bindInt(2, moduleId);
+        stmt.bindInt(3, lineNum);
+        success = runStatement(PS_InsertType);
         if(success)
             {
-            success = execSelectLastInsertedRowId(typeId);
+            typeId = getLastInsertRowId();
+            mTypeIds[name] = typeId;
             }
         }
     return success;
@@ -255,18 +346,19 @@ bool OovDatabase::addTypeRelation(OovStringRef supplierName, OovStringRef consum
     {
     int idSupplier = UNDEFINED_INT;
     int idConsumer = UNDEFINED_INT;
-    bool success = execSelectId("idType", "Type", "name", supplierName, true, idSupplier);
+    bool success = getTypeId(supplierName, true, idSupplier);
     if(success && idSupplier != UNDEFINED_INT)
         {
-        success = execSelectId("idType", "Type", "name", consumerName, true, idConsumer);
+        success = getTypeId(consumerName, true, idConsumer);
         }
     if(success && idSupplier != UNDEFINED_INT && idConsumer != UNDEFINED_INT)
         {
-        DbString ins;
-        ins.INSERT("TypeRelation").INTO({"idTypeRelation",
-            "typeRelationDescription","visibility","idSupplierType","idConsumerType"}).
-            VALUES({nullptr, tr, visibility, idSupplier, idConsumer});
-        success = exec(ins.getDbStr());
+        SQLiteStatement &stmt = mStatements[PS_InsertTypeRelation];
+        stmt.bindInt(1, tr);
+        stmt.bindInt(2, visibility);
+        stmt.bindInt(3, idSupplier);
+        stmt.bindInt(4, idConsumer);
+        success = runStatement(PS_InsertTypeRelation);
         }
     return success;
     }
@@ -277,43 +369,47 @@ bool OovDatabase::addModuleRelation(OovStringRef supplierName, OovStringRef cons
     int idConsumer = UNDEFINED_INT;
     // At the moment, the external project includes are not added previously,
     // so they will not be found to add relations.
-    bool success = execSelectId("idModule", "Module", "name", supplierName, false, idSupplier);
+    bool success = getModuleId(supplierName, false, idSupplier);
     if(success && idSupplier != UNDEFINED_INT)
         {
-        success = execSelectId("idModule", "Module", "name", consumerName, false, idConsumer);
+        success = getModuleId(consumerName, false, idConsumer);
         }
     if(success && idSupplier != UNDEFINED_INT && idConsumer != UNDEFINED_INT)
         {
-        DbString ins;
-        ins.INSERT("ModuleRelation").INTO({"idModuleRelation",
-            "idSupplierModule","idConsumerModule"}).
-            VALUES({nullptr, idSupplier, idConsumer});
-        success = exec(ins.getDbStr());
+        SQLiteStatement &stmt = mStatements[PS_InsertModuleRelation];
+        stmt.bindInt(1, idSupplier);
+        stmt.bindInt(2, idConsumer);
+        success = runStatement(PS_InsertModuleRelation);
         }
     return success;
     }
 
-bool OovDatabase::getMethodId(int idClass, OovStringRef name, bool failMissing, int &methodId)
+bool OovDatabase::getMethodId(int idClass, OovStringRef name, bool failMissing,
+    int &methodId)
     {
-    return execSelectId("idMethod", "Method", "name", name, failMissing, methodId);
+    return getMappedId(mMethodIds, "Method", name, failMissing, methodId);
     }
 
 bool OovDatabase::addMethod(OovStringRef name, int lineNum, int visibility,
     bool isConst, bool isVirt, int owningTypeId, int owningModuleId, int &methodId)
     {
-    DbString ins;
     methodId = UNDEFINED_INT;
     bool success = getMethodId(owningTypeId, name, false, methodId);
     if(success && methodId == UNDEFINED_INT)
         {
-        ins.INSERT("Method").INTO({"idMethod","name","lineNumber",
-            "visibility", "const", "virtual", "idOwningType", "idOwningModule"}).
-            VALUES({nullptr, name.getStr(), lineNum, visibility, isConst, isVirt,
-            owningTypeId, owningModuleId});
-        success = exec(ins.getDbStr());
+        SQLiteStatement &stmt = mStatements[PS_InsertMethod];
+        stmt.bindText(1, name);
+        stmt.bindInt(2, lineNum);
+        stmt.bindInt(3, visibility);
+        stmt.bindInt(4, isConst);
+        stmt.bindInt(5, isVirt);
+        stmt.bindInt(6, owningTypeId);
+        stmt.bindInt(7, owningModuleId);
+        success = runStatement(PS_InsertMethod);
         if(success)
             {
-            success = execSelectLastInsertedRowId(methodId);
+            methodId = getLastInsertRowId();
+            mMethodIds[name] = methodId;
             }
         }
     return success;
@@ -322,22 +418,24 @@ bool OovDatabase::addMethod(OovStringRef name, int lineNum, int visibility,
 bool OovDatabase::addMethodTypeRef(OovStringRef identName, eVarRelations varRel,
     int idOwningMethod, int idSupplierType)
     {
-    DbString ins;
-    ins.INSERT("MethodTypeRef").INTO({"idMethodTypeRef","name",
-        "varRelationDescription","idOwningMethod", "idSupplierType"}).
-        VALUES({nullptr, identName.getStr(), varRel, idOwningMethod, idSupplierType});
-    return exec(ins.getDbStr());
+    SQLiteStatement &stmt = mStatements[PS_InsertMethodTypeRef];
+    stmt.bindText(1, identName);
+    stmt.bindInt(2, varRel);
+    stmt.bindInt(3, idOwningMethod);
+    stmt.bindInt(4, idSupplierType);
+    return runStatement(PS_InsertMethodTypeRef);
     }
 
 bool OovDatabase::addStatement(int statementType, int lineNum, int idOwningMethod,
     int idSupplierClass, int idSupplierMethod)
     {
-    DbString ins;
-    ins.INSERT("Statement").INTO({"idStatement", "statementDescription",
-        "lineNumber","idOwningMethod","idSupplierClass", "idSupplierMethod"}).
-        VALUES({nullptr,statementType, lineNum, idOwningMethod,
-        idSupplierClass, idSupplierMethod});
-    return exec(ins.getDbStr());
+    SQLiteStatement &stmt = mStatements[PS_InsertStatement];
+    stmt.bindInt(1, statementType);
+    stmt.bindInt(2, lineNum);
+    stmt.bindInt(3, idOwningMethod);
+    stmt.bindInt(4, idSupplierClass);
+    stmt.bindInt(5, idSupplierMethod);
+    return runStatement(PS_InsertStatement);
     }
 
 
@@ -9,9 +9,13 @@
 
 #include "SQLiteImport.h"
 #include "DbString.h"           // For DbNames and DbValues
+#include <map>
 
 #define UNDEFINED_INT -1
 
+/// The database is created new each time it is written, so the IDs of all
+/// names that have been added are kept in memory, and rows are added using
+/// prepared statements instead of building SQL text for every row.
 class OovDatabase:public SQLite, public SQLiteListener
     {
     public:
@@ -21,11 +25,14 @@ class OovDatabase:public SQLite, public SQLiteListener
             }
         virtual ~OovDatabase()
             {}
-        /// Create all of the tables needed for the database.
+        /// Create all of the tables needed for the database, and prepare the
+        /// statements that add rows.
         bool createTables();
+        /// Finalize the prepared statements and close the database.
+        void closeDatabase();
 //        bool initIntegrity()
 //            { return exec("PRAGMA foreign_keys = ON"); }
-        /// Query the Module table by name to find the module ID.
+        /// Find the module ID of a module that was added.
         /// @param name The module name to search for.
         /// @param failMissing Set true to set an error string and fail the return.
         /// @param moduleId The returned module ID.
@@ -48,7 +55,7 @@ class OovDatabase:public SQLite, public SQLiteListener
         /// @param componentId The owning component.
         bool updateModuleWithComponent(OovStringRef name, int componentId);
 
-        /// Query the Type table by name to find the type ID.
+        /// Find the type ID of a type that was added.
         /// @param name The type name.
         /// @param failMissing Set true to set an error string and fail the return.
         /// @param id The returned type ID.
@@ -76,8 +83,9 @@ class OovDatabase:public SQLite, public SQLiteListener
         /// @param consumerName The consumer of the relation. The consumer is
         ///     dependent on the supplier.
         bool addModuleRelation(OovStringRef supplierName, OovStringRef consumerName);
-        /// Query the Method table by name to find the method ID.
-        /// @param idClass The ID of the class that defines the method.
+        /// Find the method ID of a method that was added.
+        /// @param idClass The ID of the class that defines the method. This
+        ///     is not used, methods are only found by name.
         /// @param name The name of the method.
         /// @param failMissing Set true to set an error string and fail the return.
         /// @param id The returned method id.
@@ -144,15 +152,29 @@ class OovDatabase:public SQLite, public SQLiteListener
             { return(mLastResults.size() > 0); }
 
     private:
+        enum ePreparedStatements
+            {
+            PS_InsertModule, PS_UpdateModuleComponent, PS_InsertComponent,
+            PS_InsertType, PS_InsertTypeRelation, PS_InsertModuleRelation,
+            PS_InsertMethod, PS_InsertMethodTypeRef, PS_InsertStatement,
+            PS_NumStatements
+            };
         std::vector<OovString> mLastResults;
         OovString mLastError;
         OovString mSqlError;
+        SQLiteStatement mStatements[PS_NumStatements];
+        /// The IDs of the names that have been added to each table.
+        std::map<OovString, int> mModuleIds;
+        std::map<OovString, int> mComponentIds;
+        std::map<OovString, int> mTypeIds;
+        std::map<OovString, int> mMethodIds;
 
-        bool addName(OovStringRef colIdName, OovStringRef tableName,
-                OovStringRef nameColName, OovStringRef nameValName, int &retId);
-        bool addRecord(OovStringRef colIdName, OovStringRef tableName,
-            OovStringRef srchColName, OovStringRef srchColVal,
-            DbNames insertColNames, DbValues insertColValues, int &retId);
+        bool prepareStatements();
+        /// Runs a prepared statement and sets an error if there is one.
+        bool runStatement(ePreparedStatements ps);
+        /// Returns id of UNDEFINED_INT if the name was not added.
+        bool getMappedId(std::map<OovString, int> const &idMap,
+            OovStringRef table, OovStringRef name, bool failMissing, int &id);
         virtual void SQLError(int retCode, char const *errMsg) override
             {
             mSqlError = errMsg;
@@ -494,7 +494,7 @@ bool DbWriter::writeAssociations()
 
 void DbWriter::closeDatabase()
     {
-    mDb.closeDb();
+    mDb.closeDatabase();
     }
 
 extern "C"
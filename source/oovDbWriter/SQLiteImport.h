@@ -17,7 +17,10 @@
 extern "C"
 {
 typedef struct sqlite3 sqlite3;
+typedef struct sqlite3_stmt sqlite3_stmt;
+typedef long long int sqlite3_int64;
 typedef int (*SQLite_callback)(void*,int,char**,char**);
+typedef void (*SQLite_destructor)(void*);
 
 struct SQLiteInterface
     {
@@ -27,12 +30,27 @@ struct SQLiteInterface
         SQLite_callback callback, void *callback_data,
         char **errmsg);
     void (*sqlite3_free)(void*);
+    int (*sqlite3_prepare_v2)(sqlite3 *pDb, const char *sql, int nByte,
+        sqlite3_stmt **ppStmt, const char **pzTail);
+    int (*sqlite3_bind_int)(sqlite3_stmt *pStmt, int index, int val);
+    int (*sqlite3_bind_text)(sqlite3_stmt *pStmt, int index, const char *val,
+        int nByte, SQLite_destructor destructor);
+    int (*sqlite3_bind_null)(sqlite3_stmt *pStmt, int index);
+    int (*sqlite3_step)(sqlite3_stmt *pStmt);
+    int (*sqlite3_reset)(sqlite3_stmt *pStmt);
+    int (*sqlite3_finalize)(sqlite3_stmt *pStmt);
+    sqlite3_int64 (*sqlite3_last_insert_rowid)(sqlite3 *pDb);
+    const char *(*sqlite3_errmsg)(sqlite3 *pDb);
     };
 };
 
 // This is normally defined in sqlite3.h, so if more error codes are needed,
 // get them from there.
 #define SQLITE_OK 0
+#define SQLITE_ROW 100
+#define SQLITE_DONE 101
+// Makes SQLite copy the bound text.
+#define SQLITE_TRANSIENT (reinterpret_cast<SQLite_destructor>(-1))
 
 /// This loads the symbols from the DLL into the interface.
 class SQLiteImporter:public SQLiteInterface, public OovLibrary
@@ -45,6 +63,16 @@ class SQLiteImporter:public SQLiteInterface, public OovLibrary
             loadModuleSymbol("sqlite3_exec", (OovProcPtr*)&sqlite3_exec);
             // This must be called for returned error strings.
             loadModuleSymbol("sqlite3_free", (OovProcPtr*)&sqlite3_free);
+            loadModuleSymbol("sqlite3_prepare_v2", (OovProcPtr*)&sqlite3_prepare_v2);
+            loadModuleSymbol("sqlite3_bind_int", (OovProcPtr*)&sqlite3_bind_int);
+            loadModuleSymbol("sqlite3_bind_text", (OovProcPtr*)&sqlite3_bind_text);
+            loadModuleSymbol("sqlite3_bind_null", (OovProcPtr*)&sqlite3_bind_null);
+            loadModuleSymbol("sqlite3_step", (OovProcPtr*)&sqlite3_step);
+            loadModuleSymbol("sqlite3_reset", (OovProcPtr*)&sqlite3_reset);
+            loadModuleSymbol("sqlite3_finalize", (OovProcPtr*)&sqlite3_finalize);
+            loadModuleSymbol("sqlite3_last_insert_rowid",
+                (OovProcPtr*)&sqlite3_last_insert_rowid);
+            loadModuleSymbol("sqlite3_errmsg", (OovProcPtr*)&sqlite3_errmsg);
             }
     };
 
@@ -104,6 +132,38 @@ class SQLite:public SQLiteImporter
                 }
             return success;
             }
+        /// Compile an SQL statement so that it can be run many times with
+        /// different bound values.
+        /// @param sql The SQL statement. Use '?' for values that are bound.
+        /// @param stmt The returned statement. This must be finalized with
+        ///     finalizeStatement before the database is closed.
+        bool prepareStatement(const char *sql, sqlite3_stmt **stmt)
+            {
+            int retCode = sqlite3_prepare_v2(mDb, sql, -1, stmt, nullptr);
+            return handleRetCode(retCode, sqlite3_errmsg(mDb));
+            }
+        /// Run a prepared statement that does not return rows, then reset
+        /// it so that new values can be bound.
+        bool stepStatement(sqlite3_stmt *stmt)
+            {
+            int retCode = sqlite3_step(stmt);
+            bool success = (retCode == SQLITE_DONE || retCode == SQLITE_ROW);
+            if(!success)
+                {
+                handleRetCode(retCode, sqlite3_errmsg(mDb));
+                }
+            sqlite3_reset(stmt);
+            return success;
+            }
+        void finalizeStatement(sqlite3_stmt *stmt)
+            {
+            sqlite3_finalize(stmt);
+            }
+        /// Get the row ID of the last inserted row.
+        int getLastInsertRowId()
+            {
+            return static_cast<int>(sqlite3_last_insert_rowid(mDb));
+            }
         /// This is called from the destructor, so does not need an additional
         /// call unless it must be closed early.
         void closeDb()
@@ -142,3 +202,60 @@ class SQLite:public SQLiteImporter
             return(retCode == SQLITE_OK);
             }
     };
+
+/// A prepared statement that is compiled once, and then run many times with
+/// different values. The values are bound using an index that starts at one
+/// for the first '?' in the SQL statement.
+class SQLiteStatement
+    {
+    public:
+        SQLiteStatement():
+            mSQLite(nullptr), mStmt(nullptr), mSql("")
+            {}
+        ~SQLiteStatement()
+            {
+            finalize();
+            }
+        bool prepare(SQLite &sqlite, char const *sql)
+            {
+            finalize();
+            mSQLite = &sqlite;
+            mSql = sql;
+            return mSQLite->prepareStatement(sql, &mStmt);
+            }
+        void bindInt(int index, int val)
+            { mSQLite->sqlite3_bind_int(mStmt, index, val); }
+        /// @param val Use nullptr to bind NULL. The text is copied.
+        void bindText(int index, char const *val)
+            {
+            if(val)
+                {
+                mSQLite->sqlite3_bind_text(mStmt, index, val, -1, SQLITE_TRANSIENT);
+                }
+            else
+                {
+                mSQLite->sqlite3_bind_null(mStmt, index);
+                }
+            }
+        /// Run the statement with the bound values.
+        bool step()
+            { return mSQLite->stepStatement(mStmt); }
+        /// This must be called before the database is closed. This is called
+        /// from the destructor, so does not need an additional call unless
+        /// the database is closed first.
+        void finalize()
+            {
+            if(mStmt)
+                {
+                mSQLite->finalizeStatement(mStmt);
+                mStmt = nullptr;
+                }
+            }
+        char const *getSql() const
+            { return mSql; }
+
+    private:
+        SQLite *mSQLite;
+        sqlite3_stmt *mStmt;
+        char const *mSql;
+    };
@@ -4,16 +4,14 @@
 
 import java.io.PrintWriter;
 import java.io.IOException;
-import java.io.FileNotFoundException;
-import java.io.RandomAccessFile;
 import java.nio.file.Files;
 import java.nio.file.Paths;
 import java.util.HashMap;
-import java.util.ArrayList;
 import java.util.Iterator;
 
 import model.*;
 import parser.*;
+import common.*;
 
 class XmlFile
     {
@@ -210,29 +208,23 @@ public class JavaModelWriter
             { dir += "/"; }
         }
 
-    String getAnalysisIncDepsFilename(String outDir)
-        {
-        String incDepFn = outDir;
-        ensureLastPathSep(incDepFn);
-        incDepFn += "oovaide-incdeps.txt";
-        return incDepFn;
-        }
-
     // Format is:    fn | time ; time; incpath ; incname ;
     // where incpath and incname are repeated for each imported file.
     String getImportStr(ModelData model, String srcRootDir, String absSrcFn)
         {
         ensureLastPathSep(srcRootDir);
+        // If there are no imports, the time values are still written so
+        // that the merge removes the old imports.
         String str = "";
+        str += absSrcFn;
+        str += '|';
+        int time = (int)(System.currentTimeMillis() / 1000L);
+        str += Integer.toString(time);	// Last parser update time
+        str += ';';
+        str += Integer.toString(time);  // Last parser check time - NOT UPDATED!
+        str += ';';
         if(model.getImports().size() > 0)
             {
-            str += absSrcFn;
-            str += '|';
-            int time = (int)(System.currentTimeMillis() / 1000L);
-            str += Integer.toString(time);	// Last parser update time
-            str += ';';
-            str += Integer.toString(time);  // Last parser check time - NOT UPDATED!
-            str += ';';
             for(String importStr : model.getImports())
                 {
                 importStr = importStr.replace("import ", "");
@@ -260,104 +252,23 @@ public class JavaModelWriter
         return str;
         }
 
-    void sleepMs(int ms)
-        {
-        try
-            {
-            Thread.sleep(ms);
-            }
-        catch(InterruptedException ex)
-            {
-            Thread.currentThread().interrupt();
-            }
-        }
-
+    // Each parsed file has a separate fragment file that oovBuilder merges
+    // into the oovaide-incdeps.txt file, so no file locking is needed.
     void writeImportDependencies(ModelData model, String absSrcFn,
         String srcRootDir, String outDir)
         {
-        // Follow a similar technique as oovCppWriter/SharedFile::open
-        String incDepFn = getAnalysisIncDepsFilename(outDir);
-        RandomAccessFile file = null;
-        for(int i=0; i<50; i++)
+        String fragmentDir = Common.getAbsPath(outDir) + "/incdeps";
+        Common.ensurePathExists(fragmentDir);
+        String fragmentFn = Common.getOutputFileName(absSrcFn, srcRootDir,
+            fragmentDir, "txt");
+        try
             {
-            try
-                {
-                try
-                    {
-                    file = new RandomAccessFile(incDepFn, "rw");
-                    break;
-                    }
-                catch(FileNotFoundException e)
-                    {
-                    file = new RandomAccessFile(incDepFn, "w");
-                    break;
-                    }
-                }
-            catch(IOException e)
-                {
-                }
-            sleepMs(100);
+            PrintWriter file = new PrintWriter(fragmentFn, "UTF-8");
+            file.println(getImportStr(model, srcRootDir, absSrcFn));
+            file.close();
             }
-       if(file != null)
+        catch(IOException e)
             {
-            ArrayList<String> lines = new ArrayList<String>();
-            boolean keepReading = true;
-            while(keepReading)
-                {
-                try
-                    {
-                    String str = file.readLine();
-                    if(str != null)
-                        {
-                        str.trim();
-                        lines.add(str);
-                        }
-                    else
-                        { keepReading = false; }
-                    }
-                catch(IOException e)
-                    {
-                    keepReading = false;
-                    }
-                }
-
-            for(int i=0; i<lines.size(); i++)
-                {
-                String line = lines.get(i);
-                int barIndex = line.indexOf('|');
-                // If there are no imports, there is no bar.
-                if(barIndex != -1)
-                    {
-                    if(line.substring(0, barIndex).compareTo(absSrcFn) == 0)
-                        {
-                        lines.remove(i);
-                        break;
-                        }
-                    }
-                }
-            String importStr = getImportStr(model, srcRootDir, absSrcFn);
-            if(importStr.length() > 0)
-                {
-                lines.add(importStr);
-                }
-
-            try
-                {
-                if(importStr.length() > 0)
-                    {
-                    file.seek(0);
-                    for(String line : lines)
-                        {
-                        file.writeBytes(line);
-                        file.writeBytes(System.getProperty("line.separator"));
-                        }
-                    file.setLength(file.getFilePointer());
-                    }
-                file.close();
-                }
-            catch(IOException e)
-                {
-                }
             }
         }
 
@@ -0,0 +1,591 @@
+/*
+ * ClassForceLayout.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *  \copyright 2026 DCBlaha.  Distributed under the GPL.
+ */
+
+#include "ClassForceLayout.h"
+#include "ClassGraph.h"
+#include <math.h>
+#include <random>
+#include <algorithm>
+
+static const int NumIterations = 150;
+/// The number of times a node is moved away from nodes that it overlaps
+/// before it is moved away from the center.
+static const int MaxOverlapMoves = 20;
+/// Cells that are smaller than this relative to the distance to the node are
+/// used as a single mass.
+static const double BarnesHutTheta = 0.8;
+/// Pulls all nodes toward the center so that unconnected nodes stay near.
+static const double Gravity = 0.05;
+/// Limits the repulsion of nodes that overlap.
+static const double MinEdgeDist = 1.0;
+
+/// A Barnes-Hut quad tree that holds the total mass and the center of mass
+/// of the nodes in each cell.
+class ForceQuadTree
+    {
+    public:
+        void build(std::vector<double> const &posX, std::vector<double> const &posY,
+            std::vector<double> const &masses, std::vector<double> const &radii);
+        /// Adds the repulsion from all other nodes to the force.
+        void addRepulsion(size_t node, double repulsion,
+            double &forceX, double &forceY) const;
+
+    private:
+        static const size_t NoNode = static_cast<size_t>(-1);
+        /// Past this depth, nodes that are almost at the same position are
+        /// combined into one cell.
+        static const int MaxDepth = 30;
+        struct Cell
+            {
+            Cell(double minX, double minY, double size):
+                mMinX(minX), mMinY(minY), mSize(size), mMassX(0), mMassY(0),
+                mMass(0), mNode(NoNode)
+                {
+                std::fill(std::begin(mChildren), std::end(mChildren), 0);
+                }
+            double mMinX;
+            double mMinY;
+            double mSize;
+            /// These are the mass times the positions until the build is
+            /// complete, and then they are the center of mass.
+            double mMassX;
+            double mMassY;
+            double mMass;
+            size_t mNode;
+            /// Zero means that there is no child, since the root is never a
+            /// child.
+            size_t mChildren[4];
+            bool isLeaf() const
+                { return(mChildren[0] == 0 && mChildren[1] == 0 &&
+                    mChildren[2] == 0 && mChildren[3] == 0); }
+            };
+        std::vector<Cell> mCells;
+        std::vector<double> const *mPosX;
+        std::vector<double> const *mPosY;
+        std::vector<double> const *mMasses;
+        std::vector<double> const *mRadii;
+
+        void insert(size_t node);
+        /// Returns the child cell index for the position, and adds the
+        /// child if it does not exist.
+        size_t getChild(size_t cellIndex, double x, double y);
+    };
+
+const size_t ForceQuadTree::NoNode;
+
+void ForceQuadTree::build(std::vector<double> const &posX,
+        std::vector<double> const &posY, std::vector<double> const &masses,
+        std::vector<double> const &radii)
+    {
+    mPosX = &posX;
+    mPosY = &posY;
+    mMasses = &masses;
+    mRadii = &radii;
+    double minX = *std::min_element(posX.begin(), posX.end());
+    double maxX = *std::max_element(posX.begin(), posX.end());
+    double minY = *std::min_element(posY.begin(), posY.end());
+    double maxY = *std::max_element(posY.begin(), posY.end());
+    mCells.clear();
+    mCells.push_back(Cell(minX, minY, std::max(std::max(maxX-minX, maxY-minY), 1.0)));
+    for(size_t ni=0; ni<posX.size(); ni++)
+        {
+        insert(ni);
+        }
+    for(auto &cell : mCells)
+        {
+        if(cell.mMass > 0)
+            {
+            cell.mMassX /= cell.mMass;
+            cell.mMassY /= cell.mMass;
+            }
+        }
+    }
+
+size_t ForceQuadTree::getChild(size_t cellIndex, double x, double y)
+    {
+    Cell const &cell = mCells[cellIndex];
+    double halfSize = cell.mSize / 2;
+    int quadrant = 0;
+    double minX = cell.mMinX;
+    double minY = cell.mMinY;
+    if(x >= cell.mMinX + halfSize)
+        {
+        quadrant += 1;
+        minX += halfSize;
+        }
+    if(y >= cell.mMinY + halfSize)
+        {
+        quadrant += 2;
+        minY += halfSize;
+        }
+    size_t childIndex = cell.mChildren[quadrant];
+    if(childIndex == 0)
+        {
+        childIndex = mCells.size();
+        // This may move the cells, so the cell reference is not used after this.
+        mCells.push_back(Cell(minX, minY, halfSize));
+        mCells[cellIndex].mChildren[quadrant] = childIndex;
+        }
+    return childIndex;
+    }
+
+void ForceQuadTree::insert(size_t node)
+    {
+    double x = (*mPosX)[node];
+    double y = (*mPosY)[node];
+    double mass = (*mMasses)[node];
+    size_t cellIndex = 0;
+    int depth = 0;
+    bool done = false;
+    while(!done)
+        {
+        Cell &cell = mCells[cellIndex];
+        bool empty = (cell.mMass == 0);
+        cell.mMass += mass;
+        cell.mMassX += mass * x;
+        cell.mMassY += mass * y;
+        if(empty || depth >= MaxDepth)
+            {
+            if(empty)
+                {
+                cell.mNode = node;
+                }
+            done = true;
+            }
+        else
+            {
+            if(cell.mNode != NoNode)
+                {
+                // Move the existing node down to a child.
+                size_t oldNode = cell.mNode;
+                cell.mNode = NoNode;
+                size_t oldChild = getChild(cellIndex, (*mPosX)[oldNode], (*mPosY)[oldNode]);
+                Cell &oldChildCell = mCells[oldChild];
+                double oldMass = (*mMasses)[oldNode];
+                oldChildCell.mMass = oldMass;
+                oldChildCell.mMassX = oldMass * (*mPosX)[oldNode];
+                oldChildCell.mMassY = oldMass * (*mPosY)[oldNode];
+                oldChildCell.mNode = oldNode;
+                }
+            cellIndex = getChild(cellIndex, x, y);
+            depth++;
+            }
+        }
+    }
+
+void ForceQuadTree::addRepulsion(size_t node, double repulsion,
+        double &forceX, double &forceY) const
+    {
+    double x = (*mPosX)[node];
+    double y = (*mPosY)[node];
+    double mass = (*mMasses)[node];
+    std::vector<size_t> cellStack;
+    cellStack.push_back(0);
+    while(cellStack.size() > 0)
+        {
+        Cell const &cell = mCells[cellStack.back()];
+        cellStack.pop_back();
+        double dx = x - cell.mMassX;
+        double dy = y - cell.mMassY;
+        double dist2 = dx*dx + dy*dy;
+        bool leaf = cell.isLeaf();
+        if(leaf || cell.mSize * cell.mSize < BarnesHutTheta * BarnesHutTheta * dist2)
+            {
+            // Nodes at the same position are separated when overlaps
+            // are removed.
+            if(cell.mNode != node && dist2 > 1e-6)
+                {
+                double dist = sqrt(dist2);
+                // Nearby nodes repel based on the distance between their
+                // edges instead of their centers.
+                double edgeDist = dist;
+                if(cell.mNode != NoNode)
+                    {
+                    edgeDist = std::max(dist - (*mRadii)[node] -
+                        (*mRadii)[cell.mNode], MinEdgeDist);
+                    }
+                double force = repulsion * mass * cell.mMass / edgeDist;
+                forceX += force * dx / dist;
+                forceY += force * dy / dist;
+                }
+            }
+        else
+            {
+            for(size_t child : cell.mChildren)
+                {
+                if(child != 0)
+                    {
+                    cellStack.push_back(child);
+                    }
+                }
+            }
+        }
+    }
+
+////////////////
+
+void ClassForceLayout::initNodes(ClassGraph const &graph,
+        std::vector<bool> const &positionedNodes)
+    {
+    size_t numNodes = graph.getNodes().size();
+    mPosX.resize(numNodes);
+    mPosY.resize(numNodes);
+    mHalfWidths.resize(numNodes);
+    mHalfHeights.resize(numNodes);
+    mMasses.resize(numNodes);
+    mRadii.resize(numNodes);
+    double totalRadius = 0;
+    for(size_t ni=0; ni<numNodes; ni++)
+        {
+        GraphSize size = graph.getNodeSizeWithPadding(ni);
+        GraphPoint pos = graph.getNodes()[ni].getPosition();
+        mHalfWidths[ni] = size.x / 2.0;
+        mHalfHeights[ni] = size.y / 2.0;
+        mPosX[ni] = pos.x + mHalfWidths[ni];
+        mPosY[ni] = pos.y + mHalfHeights[ni];
+        mRadii[ni] = (mHalfWidths[ni] + mHalfHeights[ni]) / 2;
+        totalRadius += getRadius(ni);
+        }
+    double avgRadius = std::max(totalRadius / numNodes, 1.0);
+    mIdealLength = avgRadius;
+    // Larger nodes push harder.
+    for(size_t ni=0; ni<numNodes; ni++)
+        {
+        mMasses[ni] = std::max(getRadius(ni) / avgRadius, 0.1);
+        }
+    size_t numPositioned = std::count(positionedNodes.begin(),
+        positionedNodes.end(), true);
+    mFixed.assign(numNodes, false);
+    mIncremental = (numPositioned > 0 && numPositioned < numNodes);
+    if(mIncremental)
+        {
+        mFixed = positionedNodes;
+        }
+
+    mConnectNodes.clear();
+    for(auto const &connect : graph.getConnections())
+        {
+        if(connect.first.n1 != connect.first.n2)
+            {
+            mConnectNodes.push_back(connect.first.n1);
+            mConnectNodes.push_back(connect.first.n2);
+            }
+        }
+    if(numPositioned < numNodes)
+        {
+        placeNewNodes(positionedNodes);
+        }
+    }
+
+void ClassForceLayout::placeNewNodes(std::vector<bool> const &positionedNodes)
+    {
+    size_t numNodes = mPosX.size();
+    std::vector<bool> placed = positionedNodes;
+    std::vector<std::vector<size_t>> neighbors(numNodes);
+    for(size_t ci=0; ci<mConnectNodes.size(); ci+=2)
+        {
+        neighbors[mConnectNodes[ci]].push_back(mConnectNodes[ci+1]);
+        neighbors[mConnectNodes[ci+1]].push_back(mConnectNodes[ci]);
+        }
+    // The same graph always gets the same layout.
+    std::default_random_engine generator;
+    std::uniform_real_distribution<double> jitter(-1.0, 1.0);
+    double sumX = 0;
+    double sumY = 0;
+    size_t numPlaced = 0;
+    for(size_t ni=0; ni<numNodes; ni++)
+        {
+        if(placed[ni])
+            {
+            sumX += mPosX[ni];
+            sumY += mPosY[ni];
+            numPlaced++;
+            }
+        }
+    for(size_t ni=0; ni<numNodes; ni++)
+        {
+        if(!placed[ni])
+            {
+            // Place new nodes near their placed neighbors, or anywhere near
+            // the placed nodes if there are no placed neighbors.
+            double x = 0;
+            double y = 0;
+            size_t numPlacedNeighbors = 0;
+            for(size_t neighbor : neighbors[ni])
+                {
+                if(placed[neighbor])
+                    {
+                    x += mPosX[neighbor];
+                    y += mPosY[neighbor];
+                    numPlacedNeighbors++;
+                    }
+                }
+            double spread = mIdealLength * 2;
+            if(numPlacedNeighbors > 0)
+                {
+                x /= numPlacedNeighbors;
+                y /= numPlacedNeighbors;
+                }
+            else if(numPlaced > 0)
+                {
+                x = sumX / numPlaced;
+                y = sumY / numPlaced;
+                spread = mIdealLength * 2 * sqrt(numPlaced);
+                }
+            mPosX[ni] = x + jitter(generator) * spread;
+            mPosY[ni] = y + jitter(generator) * spread;
+            placed[ni] = true;
+            sumX += mPosX[ni];
+            sumY += mPosY[ni];
+            numPlaced++;
+            }
+        }
+    }
+
+void ClassForceLayout::moveNodes(double temperature)
+    {
+    size_t numNodes = mPosX.size();
+    std::vector<double> forceX(numNodes, 0);
+    std::vector<double> forceY(numNodes, 0);
+    ForceQuadTree tree;
+    tree.build(mPosX, mPosY, mMasses, mRadii);
+    double centerX = 0;
+    double centerY = 0;
+    for(size_t ni=0; ni<numNodes; ni++)
+        {
+        centerX += mPosX[ni];
+        centerY += mPosY[ni];
+        }
+    centerX /= numNodes;
+    centerY /= numNodes;
+    double repulsion = mIdealLength * mIdealLength;
+    for(size_t ni=0; ni<numNodes; ni++)
+        {
+        if(!mFixed[ni])
+            {
+            tree.addRepulsion(ni, repulsion, forceX[ni], forceY[ni]);
+            forceX[ni] -= Gravity * mMasses[ni] * (mPosX[ni] - centerX);
+            forceY[ni] -= Gravity * mMasses[ni] * (mPosY[ni] - centerY);
+            }
+        }
+    for(size_t ci=0; ci<mConnectNodes.size(); ci+=2)
+        {
+        size_t n1 = mConnectNodes[ci];
+        size_t n2 = mConnectNodes[ci+1];
+        double dx = mPosX[n2] - mPosX[n1];
+        double dy = mPosY[n2] - mPosY[n1];
+        double dist = sqrt(dx*dx + dy*dy);
+        // Only attract if the nodes are farther apart than their sizes.
+        double stretch = dist - getRadius(n1) - getRadius(n2);
+        if(stretch > 0)
+            {
+            double force = stretch * stretch / mIdealLength;
+            forceX[n1] += force * dx / dist;
+            forceY[n1] += force * dy / dist;
+            forceX[n2] -= force * dx / dist;
+            forceY[n2] -= force * dy / dist;
+            }
+        }
+    for(size_t ni=0; ni<numNodes; ni++)
+        {
+        if(!mFixed[ni])
+            {
+            double force = sqrt(forceX[ni]*forceX[ni] + forceY[ni]*forceY[ni]);
+            if(force > 0)
+                {
+                double move = std::min(force, temperature);
+                mPosX[ni] += forceX[ni] / force * move;
+                mPosY[ni] += forceY[ni] / force * move;
+                }
+            if(mIncremental)
+                {
+                // Keep the new nodes out of negative positions so the
+                // existing nodes do not have to be moved.
+                mPosX[ni] = std::max(mPosX[ni], mHalfWidths[ni]);
+                mPosY[ni] = std::max(mPosY[ni], mHalfHeights[ni]);
+                }
+            }
+        }
+    }
+
+size_t ClassForceLayout::findOverlappingNode(size_t node,
+        std::multimap<double, size_t> const &placedNodes) const
+    {
+    size_t overlapNode = NO_INDEX;
+    double left = mPosX[node] - mHalfWidths[node];
+    double right = mPosX[node] + mHalfWidths[node];
+    // Any node that overlaps must have a left edge in this range.
+    auto endIter = placedNodes.lower_bound(right);
+    for(auto iter = placedNodes.lower_bound(left - mMaxWidth); iter != endIter; ++iter)
+        {
+        size_t other = iter->second;
+        if(fabs(mPosX[node] - mPosX[other]) < mHalfWidths[node] + mHalfWidths[other] &&
+            fabs(mPosY[node] - mPosY[other]) < mHalfHeights[node] + mHalfHeights[other])
+            {
+            overlapNode = other;
+            break;
+            }
+        }
+    return overlapNode;
+    }
+
+double ClassForceLayout::getClearPosition(double otherPos, double halfSum,
+        bool after, double halfSize) const
+    {
+    double pos = after ? otherPos + halfSum : otherPos - halfSum;
+    if(mIncremental && pos < halfSize)
+        {
+        pos = otherPos + halfSum;
+        }
+    return pos;
+    }
+
+void ClassForceLayout::removeOverlaps()
+    {
+    size_t numNodes = mPosX.size();
+    double centerX = 0;
+    double centerY = 0;
+    mMaxWidth = 0;
+    for(size_t ni=0; ni<numNodes; ni++)
+        {
+        centerX += mPosX[ni];
+        centerY += mPosY[ni];
+        mMaxWidth = std::max(mMaxWidth, mHalfWidths[ni] * 2);
+        }
+    centerX /= numNodes;
+    centerY /= numNodes;
+    // The fixed nodes are placed first, then the other nodes are placed from
+    // the center outward, so that nodes are pushed away from the center.
+    std::vector<size_t> order(numNodes);
+    std::vector<double> centerDists(numNodes);
+    for(size_t ni=0; ni<numNodes; ni++)
+        {
+        order[ni] = ni;
+        double dx = mPosX[ni] - centerX;
+        double dy = mPosY[ni] - centerY;
+        centerDists[ni] = dx*dx + dy*dy;
+        }
+    std::sort(order.begin(), order.end(), [this, &centerDists](size_t n1, size_t n2)
+        {
+        bool less;
+        if(mFixed[n1] != mFixed[n2])
+            less = mFixed[n1];
+        else if(centerDists[n1] != centerDists[n2])
+            less = centerDists[n1] < centerDists[n2];
+        else
+            less = n1 < n2;
+        return less;
+        });
+
+    // These are the placed nodes ordered by the left edges.
+    std::multimap<double, size_t> placedNodes;
+    for(size_t node : order)
+        {
+        if(!mFixed[node])
+            {
+            size_t other = findOverlappingNode(node, placedNodes);
+            for(int attempt=0; other != NO_INDEX; attempt++)
+                {
+                if(attempt < MaxOverlapMoves)
+                    {
+                    // Move the node next to the other node in the direction
+                    // that has the least overlap.
+                    double dx = mPosX[node] - mPosX[other];
+                    double dy = mPosY[node] - mPosY[other];
+                    double halfSumX = mHalfWidths[node] + mHalfWidths[other];
+                    double halfSumY = mHalfHeights[node] + mHalfHeights[other];
+                    if(halfSumX - fabs(dx) < halfSumY - fabs(dy))
+                        {
+                        mPosX[node] = getClearPosition(mPosX[other], halfSumX,
+                            dx >= 0, mHalfWidths[node]);
+                        }
+                    else
+                        {
+                        mPosY[node] = getClearPosition(mPosY[other], halfSumY,
+                            dy >= 0, mHalfHeights[node]);
+                        }
+                    }
+                else
+                    {
+                    // The node may be moving back and forth between nodes,
+                    // so move it away from the center until it is clear.
+                    double dx = mPosX[node] - centerX;
+                    double dy = mPosY[node] - centerY;
+                    double dist = sqrt(dx*dx + dy*dy);
+                    if(dist < 1)
+                        {
+                        dx = 1;
+                        dist = 1;
+                        }
+                    mPosX[node] += dx / dist * mIdealLength;
+                    mPosY[node] += dy / dist * mIdealLength;
+                    }
+                other = findOverlappingNode(node, placedNodes);
+                }
+            }
+        placedNodes.insert(std::make_pair(mPosX[node] - mHalfWidths[node], node));
+        }
+    }
+
+void ClassForceLayout::updatePositionsInGraph(ClassGraph &graph,
+        std::vector<bool> const &positionedNodes,
+        OovTaskStatusListener *listener, OovTaskContinueListener &contListener)
+    {
+    size_t numNodes = graph.getNodes().size();
+    if(numNodes > 0)
+        {
+        OovTaskStatusListenerId taskId = 0;
+        if(listener)
+            {
+            taskId = listener->startTask("Optimizing layout.", NumIterations);
+            }
+        initNodes(graph, positionedNodes);
+        // The starting temperature allows nodes to move across the diagram.
+        double startTemperature = mIdealLength * sqrt(numNodes);
+        for(int i=0; i<NumIterations && contListener.continueProcessingItem(); i++)
+            {
+            moveNodes(startTemperature * (NumIterations - i) / NumIterations);
+            if(listener && i % 10 == 0)
+                {
+                if(!listener->updateProgressIteration(taskId, i, nullptr))
+                    {
+                    break;
+                    }
+                }
+            }
+        removeOverlaps();
+
+        // An incremental layout only moves the whole diagram if a new node
+        // could not be kept out of negative positions.
+        double minX = 0;
+        double minY = 0;
+        for(size_t ni=0; ni<numNodes; ni++)
+            {
+            double x = mPosX[ni] - mHalfWidths[ni];
+            double y = mPosY[ni] - mHalfHeights[ni];
+            if(ni == 0 || x < minX)
+                minX = x;
+            if(ni == 0 || y < minY)
+                minY = y;
+            }
+        if(mIncremental)
+            {
+            minX = std::min(minX, 0.0);
+            minY = std::min(minY, 0.0);
+            }
+        for(size_t ni=0; ni<numNodes; ni++)
+            {
+            graph.getNodes()[ni].setPosition(GraphPoint(
+                static_cast<int>(lround(mPosX[ni] - mHalfWidths[ni] - minX)),
+                static_cast<int>(lround(mPosY[ni] - mHalfHeights[ni] - minY))));
+            }
+        if(listener)
+            {
+            listener->endTask(taskId);
+            }
+        }
+    }
@@ -0,0 +1,81 @@
+/*
+ * ClassForceLayout.h
+ *
+ *  Created on: Oct 16, 2026
+ *  \copyright 2026 DCBlaha.  Distributed under the GPL.
+ */
+
+#ifndef CLASSFORCELAYOUT_H_
+#define CLASSFORCELAYOUT_H_
+
+#include "OovProcess.h"
+#include <vector>
+#include <map>
+
+/// This positions the class nodes for the class diagram using a force
+/// directed layout. Connected nodes attract each other, and all nodes repel
+/// each other. The repulsion is approximated using a Barnes-Hut quad tree, so
+/// each iteration is O(n log n) instead of comparing every pair of nodes.
+/// Larger nodes repel more, and at the end any overlapping nodes are
+/// separated using the node sizes with padding.
+///
+/// This is an alternative to the ClassGenes, and is much faster for graphs
+/// with many nodes.
+class ClassForceLayout
+    {
+    public:
+        ClassForceLayout():
+            mIdealLength(0), mMaxWidth(0), mIncremental(false)
+            {}
+        /// Moves the positions into the graph.
+        /// @param positionedNodes Indicates the nodes that already have
+        ///     positions. If only some nodes have positions, the other nodes
+        ///     are placed near their connected nodes and only they are moved,
+        ///     so the existing layout is stable. If all or none of the nodes
+        ///     have positions, all nodes are moved.
+        void updatePositionsInGraph(class ClassGraph &graph,
+            std::vector<bool> const &positionedNodes,
+            OovTaskStatusListener *listener, OovTaskContinueListener &contListener);
+
+    private:
+        static const size_t NO_INDEX = static_cast<size_t>(-1);
+        // These are all indexed by node index. The positions are the centers
+        // of the nodes.
+        std::vector<double> mPosX;
+        std::vector<double> mPosY;
+        std::vector<double> mHalfWidths;
+        std::vector<double> mHalfHeights;
+        std::vector<double> mMasses;
+        /// The average of the half width and half height of each node.
+        std::vector<double> mRadii;
+        std::vector<bool> mFixed;
+        /// The node indices of the connections. Each connection is a pair of
+        /// adjacent values.
+        std::vector<size_t> mConnectNodes;
+        /// The distance between the edges of connected nodes.
+        double mIdealLength;
+        double mMaxWidth;
+        /// Only the nodes that are not fixed are moved.
+        bool mIncremental;
+
+        void initNodes(ClassGraph const &graph, std::vector<bool> const &positionedNodes);
+        void placeNewNodes(std::vector<bool> const &positionedNodes);
+        /// Moves the nodes once. The maximum distance a node can move is
+        /// the temperature.
+        void moveNodes(double temperature);
+        /// Moves nodes that are not fixed so that no nodes overlap.
+        void removeOverlaps();
+        /// Returns the position of the node so that it is just beside the
+        /// other node. This is after the other node if after is true or if
+        /// an incremental layout would have a negative position.
+        double getClearPosition(double otherPos, double halfSum, bool after,
+            double halfSize) const;
+        /// Returns NO_INDEX if the node does not overlap any placed node.
+        /// @param placedNodes The placed nodes keyed by their left edges.
+        size_t findOverlappingNode(size_t node,
+            std::multimap<double, size_t> const &placedNodes) const;
+        double getRadius(size_t node) const
+            { return mRadii[node]; }
+    };
+
+#endif
@@ -8,6 +8,7 @@
 #include "ClassGenes.h"
 #include "ClassGraph.h"
 #include <stdlib.h>     // For abs
+#include <algorithm>
 #include "Debug.h"
 #include "Gui.h"
 
@@ -34,6 +35,28 @@ void ClassGenes::initialize(const ClassGraph &graph, int avgNodeSize)
     const int sizePos = sizeof(uint16_t);
     int geneBytes = numNodes * sizePos * numPos;
     int maxPos = static_cast<int>(sqrt(numNodes) * (avgNodeSize* 1.5));
+
+    mNodeWidths.resize(numNodes);
+    mNodeHeights.resize(numNodes);
+    int totalNodeSize = 0;
+    for(int ni=0; ni<numNodes; ni++)
+        {
+        GraphSize size = graph.getNodeSizeWithPadding(ni);
+        mNodeWidths[ni] = size.x;
+        mNodeHeights[ni] = size.y;
+        totalNodeSize += std::max(size.x, size.y);
+        }
+    mGridCellSize = 1;
+    if(numNodes > 0 && totalNodeSize / numNodes > 1)
+        {
+        mGridCellSize = totalNodeSize / numNodes;
+        }
+    mConnectNodes.clear();
+    for(auto const &connect : graph.getConnections())
+        {
+        mConnectNodes.push_back(connect.first.n1);
+        mConnectNodes.push_back(connect.first.n2);
+        }
     GenePool::initialize(geneBytes, numGenes, 0.35, 0.005, 0, maxPos);
     }
 
@@ -87,16 +110,227 @@ void ClassGenes::getLineForNodes(int geneIndex, int node1, int node2, DiagramLin
     line = l;
     }
 
-bool ClassGenes::lineNodeOverlap(int geneIndex, int ni, DiagramLine const &line) const
+static bool lineRectOverlap(GraphRect const &rect, DiagramLine const &line)
     {
-    GraphRect rect;
-    getNodeRect(geneIndex, ni, rect);
     return linesOverlap(DiagramLine(rect.start.x, rect.start.y, rect.endx(), rect.start.y), line) ||
         linesOverlap(DiagramLine(rect.endx(), rect.start.y, rect.endx(), rect.endy()), line) ||
         linesOverlap(DiagramLine(rect.endx(), rect.endy(), rect.start.x, rect.endy()), line) ||
         linesOverlap(DiagramLine(rect.start.x, rect.endy(), rect.start.x, rect.start.y), line);
     }
 
+bool ClassGenes::lineNodeOverlap(int geneIndex, int ni, DiagramLine const &line) const
+    {
+    GraphRect rect;
+    getNodeRect(geneIndex, ni, rect);
+    return lineRectOverlap(rect, line);
+    }
+
+// The grid quality gives the same results as checking every pair of nodes,
+// and every line against every node, but only checks nodes that share
+// grid cells.
+#define GRID_QUALITY 1
+#if(GRID_QUALITY)
+
+/// The node rectangles for a single gene are binned into a grid of cells.
+/// Each rectangle is in every cell that it touches, including its edges.
+class GeneNodeGrid
+    {
+    public:
+        GeneNodeGrid(int cellSize, size_t numNodes);
+        void addNode(int x, int y, int width, int height);
+        /// Must be called after all nodes are added.
+        void makeGrid();
+        GraphRect getNodeRect(size_t nodeIndex) const
+            {
+            return GraphRect(mStartX[nodeIndex], mStartY[nodeIndex],
+                mEndX[nodeIndex]-mStartX[nodeIndex], mEndY[nodeIndex]-mStartY[nodeIndex]);
+            }
+        /// Gets the line between the centers of two nodes.
+        DiagramLine getCenterLine(size_t node1, size_t node2) const;
+        /// The size is the largest extent of all nodes.
+        GraphSize getSize() const
+            { return mSize; }
+        int getNodesOverlapCount() const;
+        /// Returns the number of nodes that the line overlaps.
+        int getLineNodeOverlapCount(DiagramLine const &line);
+
+    private:
+        int mCellSize;
+        int mNumCellsX;
+        int mNumCellsY;
+        GraphSize mSize;
+        std::vector<int> mStartX;
+        std::vector<int> mStartY;
+        std::vector<int> mEndX;
+        std::vector<int> mEndY;
+        /// The index into mCellNodes for each cell. There is one extra value
+        /// at the end that is the end of the last cell.
+        std::vector<size_t> mCellStarts;
+        std::vector<int> mCellNodes;
+        /// Used to prevent checking a node more than once for a line.
+        std::vector<int> mNodeLineIds;
+        int mLineId;
+
+        int getCell(int pos) const
+            { return pos / mCellSize; }
+        size_t getCellIndex(int cellX, int cellY) const
+            { return static_cast<size_t>(cellY) * mNumCellsX + cellX; }
+    };
+
+GeneNodeGrid::GeneNodeGrid(int cellSize, size_t numNodes):
+    mCellSize(cellSize), mNumCellsX(0), mNumCellsY(0), mLineId(0)
+    {
+    mStartX.reserve(numNodes);
+    mStartY.reserve(numNodes);
+    mEndX.reserve(numNodes);
+    mEndY.reserve(numNodes);
+    }
+
+void GeneNodeGrid::addNode(int x, int y, int width, int height)
+    {
+    mStartX.push_back(x);
+    mStartY.push_back(y);
+    mEndX.push_back(x + width);
+    mEndY.push_back(y + height);
+    if(x + width > mSize.x)
+        mSize.x = x + width;
+    if(y + height > mSize.y)
+        mSize.y = y + height;
+    }
+
+void GeneNodeGrid::makeGrid()
+    {
+    size_t numNodes = mStartX.size();
+    // Keep the number of cells proportional to the number of nodes.
+    while(static_cast<size_t>(getCell(mSize.x) + 1) * (getCell(mSize.y) + 1) >
+        numNodes * 4 + 16)
+        {
+        mCellSize *= 2;
+        }
+    mNumCellsX = getCell(mSize.x) + 1;
+    mNumCellsY = getCell(mSize.y) + 1;
+    // Count the nodes in each cell, then fill the cells.
+    mCellStarts.assign(static_cast<size_t>(mNumCellsX) * mNumCellsY + 1, 0);
+    for(size_t ni=0; ni<numNodes; ni++)
+        {
+        for(int cy=getCell(mStartY[ni]); cy<=getCell(mEndY[ni]); cy++)
+            {
+            for(int cx=getCell(mStartX[ni]); cx<=getCell(mEndX[ni]); cx++)
+                {
+                mCellStarts[getCellIndex(cx, cy)+1]++;
+                }
+            }
+        }
+    for(size_t ci=1; ci<mCellStarts.size(); ci++)
+        {
+        mCellStarts[ci] += mCellStarts[ci-1];
+        }
+    mCellNodes.resize(mCellStarts.back());
+    std::vector<size_t> fillPos(mCellStarts.begin(), mCellStarts.end()-1);
+    for(size_t ni=0; ni<numNodes; ni++)
+        {
+        for(int cy=getCell(mStartY[ni]); cy<=getCell(mEndY[ni]); cy++)
+            {
+            for(int cx=getCell(mStartX[ni]); cx<=getCell(mEndX[ni]); cx++)
+                {
+                mCellNodes[fillPos[getCellIndex(cx, cy)]++] = static_cast<int>(ni);
+                }
+            }
+        }
+    mNodeLineIds.assign(numNodes, 0);
+    }
+
+DiagramLine GeneNodeGrid::getCenterLine(size_t node1, size_t node2) const
+    {
+    return DiagramLine(
+        mStartX[node1] + (mEndX[node1]-mStartX[node1])/2,
+        mStartY[node1] + (mEndY[node1]-mStartY[node1])/2,
+        mStartX[node2] + (mEndX[node2]-mStartX[node2])/2,
+        mStartY[node2] + (mEndY[node2]-mStartY[node2])/2);
+    }
+
+int GeneNodeGrid::getNodesOverlapCount() const
+    {
+    int count = 0;
+    for(int cy=0; cy<mNumCellsY; cy++)
+        {
+        for(int cx=0; cx<mNumCellsX; cx++)
+            {
+            size_t cellIndex = getCellIndex(cx, cy);
+            size_t cellEnd = mCellStarts[cellIndex+1];
+            for(size_t i1=mCellStarts[cellIndex]; i1<cellEnd; i1++)
+                {
+                int n1 = mCellNodes[i1];
+                for(size_t i2=i1+1; i2<cellEnd; i2++)
+                    {
+                    int n2 = mCellNodes[i2];
+                    bool overlap = ((mEndX[n1] >= mStartX[n2]) &&
+                        (mEndY[n1] >= mStartY[n2]) &&
+                        (mStartX[n1] <= mEndX[n2]) &&
+                        (mStartY[n1] <= mEndY[n2]));
+                    // Overlapping nodes share all cells of the overlapping
+                    // area, so only count them in the top left cell.
+                    if(overlap &&
+                        getCell(std::max(mStartX[n1], mStartX[n2])) == cx &&
+                        getCell(std::max(mStartY[n1], mStartY[n2])) == cy)
+                        {
+                        count++;
+                        }
+                    }
+                }
+            }
+        }
+    return count;
+    }
+
+int GeneNodeGrid::getLineNodeOverlapCount(DiagramLine const &line)
+    {
+    int count = 0;
+    mLineId++;
+    int minX = std::min(line.s.x, line.e.x);
+    int maxX = std::max(line.s.x, line.e.x);
+    int dx = line.e.x - line.s.x;
+    int dy = line.e.y - line.s.y;
+    // Go through each column of cells that the line is in, and find the
+    // range of Y cells for the part of the line in the column. The range is
+    // expanded by one to prevent rounding errors from missing a cell.
+    for(int cx=getCell(minX); cx<=getCell(maxX); cx++)
+        {
+        double startY = std::min(line.s.y, line.e.y);
+        double endY = std::max(line.s.y, line.e.y);
+        if(dx != 0)
+            {
+            int colStartX = std::max(minX, cx * mCellSize);
+            int colEndX = std::min(maxX, (cx+1) * mCellSize);
+            double y1 = line.s.y + static_cast<double>(colStartX - line.s.x) * dy / dx;
+            double y2 = line.s.y + static_cast<double>(colEndX - line.s.x) * dy / dx;
+            startY = std::max(startY, std::min(y1, y2) - 1);
+            endY = std::min(endY, std::max(y1, y2) + 1);
+            }
+        int startCellY = std::max(getCell(static_cast<int>(startY)), 0);
+        int endCellY = std::min(getCell(static_cast<int>(endY)), mNumCellsY-1);
+        for(int cy=startCellY; cy<=endCellY; cy++)
+            {
+            size_t cellIndex = getCellIndex(cx, cy);
+            for(size_t i=mCellStarts[cellIndex]; i<mCellStarts[cellIndex+1]; i++)
+                {
+                int ni = mCellNodes[i];
+                if(mNodeLineIds[ni] != mLineId)
+                    {
+                    mNodeLineIds[ni] = mLineId;
+                    if(lineRectOverlap(getNodeRect(ni), line))
+                        {
+                        count++;
+                        }
+                    }
+                }
+            }
+        }
+    return count;
+    }
+
+#endif
+
 #else
 
 bool ClassGenes::isDistanceGoodQuality(int geneIndex, int ni1, int ni2) const
@@ -138,7 +372,7 @@ void ClassGenes::setupQualityEachGeneration()
 GraphSize ClassGenes::getSize(int geneIndex) const
     {
     GraphSize size;
-    for(size_t ni=0; ni<mGraph->getNodes().size(); ni++)
+    for(size_t ni=0; ni<mNodeWidths.size(); ni++)
         {
         GraphRect rect;
         getNodeRect(geneIndex, ni, rect);
@@ -152,13 +386,32 @@ GraphSize ClassGenes::getSize(int geneIndex) const
 
 QualityType ClassGenes::calculateSingleGeneQuality(size_t geneIndex) const
     {
+    int numNodes = mNodeWidths.size();
+    int numConnections = mConnectNodes.size() / 2;
+#if(GRID_QUALITY)
+    GeneNodeGrid grid(mGridCellSize, numNodes);
+    for(int ni=0; ni<numNodes; ni++)
+        {
+        GraphPoint pos;
+        getPosition(geneIndex, ni, pos);
+        grid.addNode(pos.x, pos.y, mNodeWidths[ni], mNodeHeights[ni]);
+        }
+    grid.makeGrid();
+    int nodesOverlapCount = grid.getNodesOverlapCount();
+    int lineNodeOverlapCount = 0;
+    for(size_t ci=0; ci<mConnectNodes.size(); ci+=2)
+        {
+        lineNodeOverlapCount += grid.getLineNodeOverlapCount(
+            grid.getCenterLine(mConnectNodes[ci], mConnectNodes[ci+1]));
+        }
+    GraphSize geneSize = grid.getSize();
+#else
     int nodesOverlapCount = 0;
 #if(LINES_OVERLAP)
     int lineNodeOverlapCount = 0;
 #else
     int distCount = 0;
 #endif
-    int numNodes = mGraph->getNodes().size();
     for(int ni1=0; ni1<numNodes; ni1++)
         {
         for(int ni2=ni1+1; ni2<numNodes; ni2++)
@@ -173,17 +426,18 @@ QualityType ClassGenes::calculateSingleGeneQuality(size_t geneIndex) const
             }
         }
 #if(LINES_OVERLAP)
-    int numConnections = mGraph->getConnections().size();
-    for(auto const &nodePair : mGraph->getConnections())
+    for(size_t ci=0; ci<mConnectNodes.size(); ci+=2)
         {
         DiagramLine line;
-        getLineForNodes(geneIndex, nodePair.first.n1, nodePair.first.n2, line);
+        getLineForNodes(geneIndex, mConnectNodes[ci], mConnectNodes[ci+1], line);
         for(int ni=0; ni<numNodes; ni++)
             {
             if(lineNodeOverlap(geneIndex, ni, line))
                 lineNodeOverlapCount++;
             }
         }
+#endif
+    GraphSize geneSize = getSize(geneIndex);
 #endif
     int totalNodesQ = (numNodes * (numNodes-1)) / 2;
     QualityType nodesQ = totalNodesQ - nodesOverlapCount;
@@ -194,7 +448,6 @@ QualityType ClassGenes::calculateSingleGeneQuality(size_t geneIndex) const
 #else
     QualityType lineQ = distCount;
 #endif
-    GraphSize geneSize = getSize(geneIndex);
     QualityType sizeQ = 0;
     if(geneSize.x + geneSize.y > 0)
         {
@@ -240,7 +493,7 @@ void ClassGenes::getNodeRect(int geneIndex, int nodeIndex,
         GraphRect &rect) const
     {
     // Get the size from the node, and the position from the gene pool.
-    rect.size = mGraph->getNodeSizeWithPadding(nodeIndex);
+    rect.size = GraphSize(mNodeWidths[nodeIndex], mNodeHeights[nodeIndex]);
     getPosition(geneIndex, nodeIndex, rect.start);
     }
 
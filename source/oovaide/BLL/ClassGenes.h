@@ -41,6 +41,15 @@ class ClassGenes:public GenePool
     private:
         const class ClassGraph *mGraph;
         GraphSize mDiagramSize;
+        /// The node sizes with padding are copied from the graph since they
+        /// are used for every gene.
+        std::vector<int> mNodeWidths;
+        std::vector<int> mNodeHeights;
+        /// The node indices of the connections. Each connection is a pair of
+        /// adjacent values.
+        std::vector<int> mConnectNodes;
+        /// The size of the cells used to find nodes that are near each other.
+        int mGridCellSize;
 
         virtual void setupQualityEachGeneration() override;
         virtual QualityType calculateSingleGeneQuality(size_t geneIndex) const override;
@@ -7,6 +7,7 @@
 
 #include "ClassGraph.h"
 #include "ClassDrawer.h"
+#include "ClassForceLayout.h"
 #include "FilePath.h"
 #include "Debug.h"
 #include <algorithm>
@@ -76,13 +77,37 @@ void ClassGraph::updateGenes(const ModelData &modelData,
     updateConnections(modelData);
     if(mNodes.size() > 1)
         {
-        mGenes.initialize(*this, getAvgNodeSize());
-        mGenes.updatePositionsInGraph(*this, mBackgroundTaskStatusListener, *this);
+        if(mGraphOptions.forceLayout)
+            {
+            std::vector<bool> positionedNodes(mNodes.size());
+            for(size_t i=0; i<mNodes.size(); i++)
+                {
+                positionedNodes[i] = (mPositionedTypes.find(mNodes[i].getType()) !=
+                    mPositionedTypes.end());
+                }
+            ClassForceLayout forceLayout;
+            forceLayout.updatePositionsInGraph(*this, positionedNodes,
+                mBackgroundTaskStatusListener, *this);
+            }
+        else
+            {
+            mGenes.initialize(*this, getAvgNodeSize());
+            mGenes.updatePositionsInGraph(*this, mBackgroundTaskStatusListener, *this);
+            }
         }
     else
         {
         // single node just ends up at 0,0
         }
+    setNodesPositioned();
+    }
+
+void ClassGraph::setNodesPositioned()
+    {
+    for(auto const &node : mNodes)
+        {
+        mPositionedTypes.insert(node.getType());
+        }
     }
 
 size_t ClassGraph::getNodeIndex(const ModelType *type) const
@@ -126,6 +151,7 @@ void ClassGraph::removeNode(const ClassNode &node)
         if(mNodes[i].getType() == node.getType())
             {
             mNodes.erase(mNodes.begin() + i);
+            mPositionedTypes.erase(node.getType());
             break;
             }
         }
@@ -143,87 +169,54 @@ bool ClassGraph::isNodeTypePresent(ClassNode const &node,
 
 
 void ClassGraph::addRelatedNodesRecurseUserToVector(const ModelData &model,
-        const ModelType *type, const ModelType *modelType, eAddNodeTypes addType,
-        int maxDepth, std::vector<ClassNode> &nodes)
+        ModelTypeUser const &user, eAddNodeTypes addType, int maxDepth,
+        std::vector<ClassNode> &nodes)
     {
-    // Add nodes for template types if they refer to the passed in type.
-    if((addType & AN_Templates) > 0)
+    switch(user.mKind)
         {
-        if(modelType->isTemplateUseType())
-            {
-            ConstModelClassifierVector relatedClassifiers;
-            model.getRelatedTypeArgClasses(*modelType, relatedClassifiers);
-            for(const auto &rc : relatedClassifiers)
+        // Add nodes for template types if they refer to the passed in type.
+        case MTU_TemplateArg:
+            if((addType & AN_Templates) > 0)
                 {
-                if(rc == type)
-                    {
 #if(DEBUG_ADD)
-                DebugAdd("Typedef Rel", modelType);
+                DebugAdd("Typedef Rel", user.mUser);
 #endif
-                    getRelatedNodesRecurse(model, modelType, addType, maxDepth,
-                            nodes);
-                    }
+                getRelatedNodesRecurse(model, user.mUser, addType, maxDepth, nodes);
                 }
-            }
-        }
-    // Add nodes if members refer to the passed in type.
-    if((addType & AN_MemberUsers) > 0)
-        {
-        const ModelClassifier*cl = ModelClassifier::getClass(modelType);
-        if(cl)
-            {
-            for(const auto &attr : cl->getAttributes())
+            break;
+
+        // Add nodes if members refer to the passed in type.
+        case MTU_Member:
+            if((addType & AN_MemberUsers) > 0)
                 {
-                const ModelType *attrType = attr->getDeclType();
-                if(attrType == type)
-                    {
 #if(DEBUG_ADD)
-                    DebugAdd("Memb User", cl);
+                DebugAdd("Memb User", user.mUser);
 #endif
-                    getRelatedNodesRecurse(model, cl, addType, maxDepth, nodes);
-                    }
+                getRelatedNodesRecurse(model, user.mUser, addType, maxDepth, nodes);
                 }
-            }
-        }
-    // Add nodes if func params refer to the passed in type.
-    if((addType & AN_FuncParamsUsers) > 0)
-        {
-        const ModelClassifier*cl = ModelClassifier::getClass(modelType);
-        if(cl)
-            {
-            ConstModelClassifierVector relatedClasses;
-            model.getRelatedFuncInterfaceClasses(*cl, relatedClasses);
-            for(auto &cls : relatedClasses)
+            break;
+
+        // Add nodes if func params refer to the passed in type.
+        case MTU_FuncParam:
+            if((addType & AN_FuncParamsUsers) > 0)
                 {
-                if(cls == type)
-                    {
 #if(DEBUG_ADD)
-                    DebugAdd("Param User", cl);
+                DebugAdd("Param User", user.mUser);
 #endif
-                    getRelatedNodesRecurse(model, cl, addType, maxDepth, nodes);
-                    }
+                getRelatedNodesRecurse(model, user.mUser, addType, maxDepth, nodes);
                 }
-            }
-        }
-    // Add nodes if func body variables refer to the passed in type.
-    if((addType & AN_FuncBodyUsers) > 0)
-        {
-        const ModelClassifier*cl = ModelClassifier::getClass(modelType);
-        if(cl)
-            {
-            ConstModelDeclClasses relatedDeclClasses;
-            model.getRelatedBodyVarClasses(*cl, relatedDeclClasses);
-            for(auto &rdc : relatedDeclClasses)
+            break;
+
+        // Add nodes if func body variables refer to the passed in type.
+        case MTU_FuncBodyVar:
+            if((addType & AN_FuncBodyUsers) > 0)
                 {
-                if(rdc.getClass() == type)
-                    {
 #if(DEBUG_ADD)
-                    DebugAdd("Var User", cl);
+                DebugAdd("Var User", user.mUser);
 #endif
-                    getRelatedNodesRecurse(model, cl, addType, maxDepth, nodes);
-                    }
+                getRelatedNodesRecurse(model, user.mUser, addType, maxDepth, nodes);
                 }
-            }
+            break;
         }
     }
 
@@ -375,16 +368,19 @@ void ClassGraph::getRelatedNodesRecurse(const ModelData &model, const ModelType
                         getComponentOptions(*type, mGraphOptions)), nodes);
                 }
             }
+        // The model has an index of the users of each type.
+        std::vector<ModelTypeUser> users;
+        model.getTypeUsers(*type, users);
         int taskId = 0;
         if(mBackgroundTaskLevel == 1)
             {
             taskId = mForegroundTaskStatusListener->startTask("Adding relations.",
-                    model.mTypes.size());
+                    users.size());
             }
-        for(size_t i=0; i<model.mTypes.size(); i++)
+        for(size_t i=0; i<users.size(); i++)
             {
-            addRelatedNodesRecurseUserToVector(model, type, model.mTypes[i].get(),
-                    addType, maxDepth, nodes);
+            addRelatedNodesRecurseUserToVector(model, users[i], addType,
+                    maxDepth, nodes);
             if(mBackgroundTaskLevel == 1)
                 {
                 if(!mForegroundTaskStatusListener->updateProgressIteration(
@@ -606,6 +602,7 @@ GraphSize ClassGraph::updateGraph(const ModelData &modelData, bool geneRepositio
         {
         updateNodeSizes();
         updateConnections(modelData);
+        setNodesPositioned();
         mGraphListener->doneRepositioning();
         }
     return(getGraphSize());
@@ -13,6 +13,7 @@
 #include "DiagramDrawer.h"
 #include "OovThreadedBackgroundQueue.h"
 #include <map>
+#include <set>
 
 
 struct ClassNodeDrawOptions
@@ -47,6 +48,11 @@ struct ClassRelationDrawOptions
 
 struct ClassDrawOptions:public ClassNodeDrawOptions, public ClassRelationDrawOptions
     {
+    ClassDrawOptions():
+        forceLayout(false)
+        {}
+    /// Use the force directed layout instead of the genetic algorithm.
+    bool forceLayout;
     };
 
 
@@ -196,6 +202,7 @@ class ClassGraph:public ThreadedWorkBackgroundQueue<ClassGraph, ClassGraphBackgr
             {
             mNodes.clear();
             mConnectMap.clear();
+            mPositionedTypes.clear();
             }
 
         /// See the addRelatedNodes function for more description.
@@ -269,6 +276,10 @@ class ClassGraph:public ThreadedWorkBackgroundQueue<ClassGraph, ClassGraphBackgr
         std::vector<ClassNode> mNodes;
         std::map<nodePair_t, ClassConnectItem> mConnectMap;
         ClassGenes mGenes;
+        /// The types of the nodes that have been positioned. This allows the
+        /// force layout to only move nodes that were added since the last
+        /// layout.
+        std::set<const ModelType*> mPositionedTypes;
         GraphSize mPad;
         bool mModified;
         int mBackgroundTaskLevel;
@@ -281,6 +292,7 @@ class ClassGraph:public ThreadedWorkBackgroundQueue<ClassGraph, ClassGraphBackgr
         static const int FIRST_CLASS_INDEX = 1;
 
         void removeNode(const ClassNode &node);
+        void setNodesPositioned();
 
         /// This updates quality information, runs the genetic algorithm for
         /// placing the nodes, and then draws them.
@@ -295,13 +307,11 @@ class ClassGraph:public ThreadedWorkBackgroundQueue<ClassGraph, ClassGraphBackgr
         void insertConnection(int node1, const ModelType *type,
             const ClassConnectItem &connectItem);
 
-        /// Checks the modelType to see if any parts of it refer to the type.
-        /// @param type The base type to compare all other types against.
-        /// @param modelType The type to check to see if any parts of it is a user
-        ///                  of the base type.
+        /// Adds the user of a type if the add type includes the kind of use.
+        /// @param user A user of the type that is being added.
         void addRelatedNodesRecurseUserToVector(const ModelData &model,
-            const ModelType *type, const ModelType *modelType,
-            eAddNodeTypes addType, int maxDepth, std::vector<ClassNode> &nodes);
+            ModelTypeUser const &user, eAddNodeTypes addType, int maxDepth,
+            std::vector<ClassNode> &nodes);
         static void addNodeToVector(const ClassNode &node, std::vector<ClassNode> &nodes);
         void addRelationKeyNode();
 
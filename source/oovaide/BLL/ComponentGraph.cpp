@@ -145,54 +145,137 @@ fflush(stdout);
         pruneConnections();
     }
 
-void ComponentGraph::findNumPaths(size_t consumerIndex, size_t supplierIndex,
-    size_t &numPaths)
+/// A set of node indices that is stored as bits.
+class NodeBitSet
     {
-    for(auto const &connection : mConnections)
+    public:
+        NodeBitSet(size_t numNodes):
+            mWords((numNodes + BitsPerWord - 1) / BitsPerWord, 0)
+            {}
+        void set(size_t nodeIndex)
+            { mWords[nodeIndex / BitsPerWord] |= getBit(nodeIndex); }
+        bool isSet(size_t nodeIndex) const
+            { return((mWords[nodeIndex / BitsPerWord] & getBit(nodeIndex)) != 0); }
+        /// Adds all nodes from the other set. Returns true if any nodes
+        /// were added.
+        bool merge(NodeBitSet const &other)
+            {
+            bool changed = false;
+            for(size_t i=0; i<mWords.size(); i++)
+                {
+                uint64_t merged = mWords[i] | other.mWords[i];
+                if(merged != mWords[i])
+                    {
+                    mWords[i] = merged;
+                    changed = true;
+                    }
+                }
+            return changed;
+            }
+
+    private:
+        static const size_t BitsPerWord = 64;
+        std::vector<uint64_t> mWords;
+
+        static uint64_t getBit(size_t nodeIndex)
+            { return(static_cast<uint64_t>(1) << (nodeIndex % BitsPerWord)); }
+    };
+
+void ComponentGraph::getSuppliersOrder(
+        std::vector<std::vector<size_t>> const &suppliers,
+        std::vector<size_t> &order) const
+    {
+    std::vector<std::vector<size_t>> consumers(mNodes.size());
+    std::vector<size_t> numWaitingSuppliers(mNodes.size());
+    for(size_t ni=0; ni<mNodes.size(); ni++)
+        {
+        numWaitingSuppliers[ni] = suppliers[ni].size();
+        for(size_t supplierIndex : suppliers[ni])
+            {
+            consumers[supplierIndex].push_back(ni);
+            }
+        }
+    order.clear();
+    for(size_t ni=0; ni<mNodes.size(); ni++)
+        {
+        if(numWaitingSuppliers[ni] == 0)
+            {
+            order.push_back(ni);
+            }
+        }
+    for(size_t oi=0; oi<order.size(); oi++)
         {
-        if(connection.mNodeConsumer == consumerIndex)
+        for(size_t consumerIndex : consumers[order[oi]])
             {
-            if(connection.mNodeSupplier == supplierIndex)
+            if(--numWaitingSuppliers[consumerIndex] == 0)
                 {
-                numPaths++;
+                order.push_back(consumerIndex);
                 }
-            else
-                findNumPaths(connection.mNodeSupplier, supplierIndex, numPaths);
+            }
+        }
+    // Nodes in dependency cycles never become ready, so add them at the end.
+    for(size_t ni=0; ni<mNodes.size(); ni++)
+        {
+        if(numWaitingSuppliers[ni] != 0)
+            {
+            order.push_back(ni);
             }
         }
     }
 
+// A connection is an implied dependency if the supplier can also be reached
+// through a different supplier of the consumer.
 void ComponentGraph::pruneConnections()
     {
-    for(auto & constConn : mConnections)
+    std::vector<std::vector<size_t>> suppliers(mNodes.size());
+    for(auto const &connection : mConnections)
         {
-        // The begin() iterator is const only in the <set> header file. Since
-        // the set sorting is not dependent on the mImpliedDependency, this code is ok.
-        ComponentConnection &connection = const_cast<ComponentConnection &>(constConn);
-        size_t numPaths = 0;
-        findNumPaths(connection.mNodeConsumer, connection.mNodeSupplier, numPaths);
-        if(numPaths > 1)
-            {
-            connection.setImpliedDependency(true);
-            }
+        suppliers[connection.mNodeConsumer].push_back(connection.mNodeSupplier);
         }
-    /*
-    std::set<ComponentConnection>::iterator iter = mConnections.begin();
-    while(iter != mConnections.end())
+    std::vector<size_t> order;
+    getSuppliersOrder(suppliers, order);
+
+    // Find all nodes that can be reached from each node. Since suppliers are
+    // ordered before consumers, a single pass is enough unless there are
+    // dependency cycles.
+    std::vector<NodeBitSet> reachable(mNodes.size(), NodeBitSet(mNodes.size()));
+    bool changed = true;
+    while(changed)
         {
-        ComponentConnection const &connection = *iter;
-        int numPaths = 0;
-        findNumPaths(connection.mNodeConsumer, connection.mNodeSupplier, numPaths);
-        if(numPaths > 1)
+        changed = false;
+        for(size_t nodeIndex : order)
             {
-            mConnections.erase(iter++);
+            NodeBitSet &nodeReachable = reachable[nodeIndex];
+            for(size_t supplierIndex : suppliers[nodeIndex])
+                {
+                if(!nodeReachable.isSet(supplierIndex))
+                    {
+                    nodeReachable.set(supplierIndex);
+                    changed = true;
+                    }
+                if(nodeReachable.merge(reachable[supplierIndex]))
+                    {
+                    changed = true;
+                    }
+                }
             }
-        else
+        }
+
+    for(auto & constConn : mConnections)
+        {
+        // The begin() iterator is const only in the <set> header file. Since
+        // the set sorting is not dependent on the mImpliedDependency, this code is ok.
+        ComponentConnection &connection = const_cast<ComponentConnection &>(constConn);
+        for(size_t supplierIndex : suppliers[connection.mNodeConsumer])
             {
-            iter++;
+            if(supplierIndex != connection.mNodeSupplier &&
+                    reachable[supplierIndex].isSet(connection.mNodeSupplier))
+                {
+                connection.setImpliedDependency(true);
+                break;
+                }
             }
         }
-*/
     }
 
 size_t ComponentGraph::getComponentIndex(OovStringVec const &compPaths,
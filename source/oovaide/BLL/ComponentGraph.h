@@ -123,8 +123,15 @@ class ComponentGraph
         void updateConnections(const ComponentDrawOptions &options);
         size_t getComponentIndex(OovStringVec const &compPaths,
                 OovStringRef const dir);
+        /// Marks the connections that are implied by other connections.
+        /// This is a transitive reduction of the connections.
         void pruneConnections();
-        void findNumPaths(size_t consumerIndex, size_t supplierIndex, size_t &numPaths);
+        /// Gets the node indices ordered so that suppliers are before their
+        /// consumers. Nodes that are in dependency cycles are at the end.
+        /// @param suppliers The supplier node indices for each node.
+        /// @param order The returned node indices.
+        void getSuppliersOrder(std::vector<std::vector<size_t>> const &suppliers,
+            std::vector<size_t> &order) const;
     };
 
 
@@ -16,6 +16,7 @@
 #include <math.h>       // for atan, sqrt
 #include <limits>
 #include <map>
+#include <algorithm>
 
 
 // Update the returned pos only if the found breakstring starting from
@@ -269,6 +270,22 @@ std::vector<int> DiagramDependencyDrawer::getColumnPositions(
     return columnSpacing;
     }
 
+void DiagramDependencyDrawer::updateColumnNodePositions(size_t nodeHeight)
+    {
+    if(mLayeredLayout)
+        {
+        DiagramDependencyLayers layers;
+        layers.initialize(*this, nodeHeight);
+        layers.updatePositionsInDrawer();
+        }
+    else
+        {
+        DiagramDependencyGenes genes;
+        genes.initialize(*this, nodeHeight);
+        genes.updatePositionsInDrawer();
+        }
+    }
+
 
 // Just use Keneth Kelly's colors
 // http://stackoverflow.com/questions/470690/how-to-automatically-generate-n-distinct-colors
@@ -526,3 +543,292 @@ size_t DiagramDependencyGenes::getDrawingHeight(size_t geneIndex) const
     return ySize;
     }
 
+////////////////
+
+static const int NumLayerSweeps = 12;
+
+size_t DiagramDependencyLayers::addNode(size_t layer)
+    {
+    size_t node = mNodeLayers.size();
+    mNodeLayers.push_back(layer);
+    mNodeOrders.push_back(mLayerNodes[layer].size());
+    mLayerNodes[layer].push_back(node);
+    mPrevNeighbors.push_back(std::vector<size_t>());
+    mNextNeighbors.push_back(std::vector<size_t>());
+    return node;
+    }
+
+void DiagramDependencyLayers::addConnection(size_t prevNode, size_t nextNode)
+    {
+    mNextNeighbors[prevNode].push_back(nextNode);
+    mPrevNeighbors[nextNode].push_back(prevNode);
+    }
+
+void DiagramDependencyLayers::initialize(DiagramDependencyDrawer &drawer,
+        size_t nodeHeight)
+    {
+    mDrawer = &drawer;
+    mNodeHeight = nodeHeight;
+    mNumDrawerNodes = drawer.getNumNodes();
+
+    // The layers were already assigned by the drawer as column positions.
+    std::map<int, size_t> columnLayers;     // First is pos, second is layer.
+    for(size_t ni=0; ni<mNumDrawerNodes; ni++)
+        {
+        columnLayers[drawer.getNodePosition(ni).x] = 0;
+        }
+    size_t layer = 0;
+    for(auto &column : columnLayers)
+        {
+        column.second = layer++;
+        }
+    mLayerNodes.resize(columnLayers.size());
+    for(size_t ni=0; ni<mNumDrawerNodes; ni++)
+        {
+        addNode(columnLayers[drawer.getNodePosition(ni).x]);
+        }
+
+    for(size_t ci=0; ci<drawer.getNumConnections(); ci++)
+        {
+        size_t consumerIndex;
+        size_t supplierIndex;
+        drawer.getConnection(ci, consumerIndex, supplierIndex);
+        size_t prevNode = std::min(consumerIndex, supplierIndex,
+            [this](size_t n1, size_t n2)
+                { return mNodeLayers[n1] < mNodeLayers[n2]; });
+        size_t lastNode = (prevNode == consumerIndex) ? supplierIndex : consumerIndex;
+        // Connections within a layer are not used for ordering.
+        if(mNodeLayers[prevNode] != mNodeLayers[lastNode])
+            {
+            for(size_t li=mNodeLayers[prevNode]+1; li<mNodeLayers[lastNode]; li++)
+                {
+                size_t dummyNode = addNode(li);
+                addConnection(prevNode, dummyNode);
+                prevNode = dummyNode;
+                }
+            addConnection(prevNode, lastNode);
+            }
+        }
+    }
+
+void DiagramDependencyLayers::updatePositionsInDrawer()
+    {
+    orderLayers();
+    assignYPositions();
+    for(size_t ni=0; ni<mNumDrawerNodes; ni++)
+        {
+        GraphPoint pos = mDrawer->getNodePosition(ni);
+        pos.y = mNodeYPositions[ni];
+        mDrawer->setNodePosition(ni, pos);
+        }
+    }
+
+void DiagramDependencyLayers::orderLayers()
+    {
+    std::vector<std::vector<size_t>> bestLayerNodes = mLayerNodes;
+    size_t bestCrossings = countCrossings();
+    // Alternate sweeping from the first layer to the last, and from the
+    // last to the first, and keep the order with the fewest crossings.
+    for(int sweep=0; sweep<NumLayerSweeps && bestCrossings > 0; sweep++)
+        {
+        bool forward = (sweep % 2 == 0);
+        for(size_t i=1; i<mLayerNodes.size(); i++)
+            {
+            if(forward)
+                {
+                orderLayerByBarycenter(i, true);
+                }
+            else
+                {
+                orderLayerByBarycenter(mLayerNodes.size()-1-i, false);
+                }
+            }
+        size_t crossings = countCrossings();
+        if(crossings < bestCrossings)
+            {
+            bestCrossings = crossings;
+            bestLayerNodes = mLayerNodes;
+            }
+        }
+    mLayerNodes = bestLayerNodes;
+    for(auto const &layerNodes : mLayerNodes)
+        {
+        for(size_t i=0; i<layerNodes.size(); i++)
+            {
+            mNodeOrders[layerNodes[i]] = i;
+            }
+        }
+    }
+
+void DiagramDependencyLayers::orderLayerByBarycenter(size_t layer,
+        bool usePrevLayer)
+    {
+    std::vector<size_t> &layerNodes = mLayerNodes[layer];
+    std::vector<double> barycenters(mNodeLayers.size());
+    for(size_t node : layerNodes)
+        {
+        std::vector<size_t> const &neighbors = usePrevLayer ?
+            mPrevNeighbors[node] : mNextNeighbors[node];
+        // Nodes without neighbors stay in the same position.
+        double barycenter = mNodeOrders[node];
+        if(neighbors.size() > 0)
+            {
+            barycenter = 0;
+            for(size_t neighbor : neighbors)
+                {
+                barycenter += mNodeOrders[neighbor];
+                }
+            barycenter /= neighbors.size();
+            }
+        barycenters[node] = barycenter;
+        }
+    std::stable_sort(layerNodes.begin(), layerNodes.end(),
+        [&barycenters](size_t n1, size_t n2)
+            { return barycenters[n1] < barycenters[n2]; });
+    for(size_t i=0; i<layerNodes.size(); i++)
+        {
+        mNodeOrders[layerNodes[i]] = i;
+        }
+    }
+
+size_t DiagramDependencyLayers::countCrossings() const
+    {
+    size_t crossings = 0;
+    for(size_t layer=0; layer+1<mLayerNodes.size(); layer++)
+        {
+        // Sort the connections by the order of the nodes in this layer, then
+        // count the connections that end lower in the next layer than
+        // connections that were already added.
+        std::vector<std::pair<size_t, size_t>> connections;
+        for(size_t node : mLayerNodes[layer])
+            {
+            for(size_t neighbor : mNextNeighbors[node])
+                {
+                connections.push_back(std::make_pair(mNodeOrders[node],
+                    mNodeOrders[neighbor]));
+                }
+            }
+        std::sort(connections.begin(), connections.end());
+        // A Fenwick tree of the counts of the next layer orders.
+        size_t numNextNodes = mLayerNodes[layer+1].size();
+        std::vector<size_t> counts(numNextNodes + 1);
+        size_t numAdded = 0;
+        for(auto const &conn : connections)
+            {
+            size_t numLowerOrEqual = 0;
+            for(size_t i=conn.second+1; i>0; i-=(i & (~i+1)))
+                {
+                numLowerOrEqual += counts[i];
+                }
+            crossings += numAdded - numLowerOrEqual;
+            for(size_t i=conn.second+1; i<=numNextNodes; i+=(i & (~i+1)))
+                {
+                counts[i]++;
+                }
+            numAdded++;
+            }
+        }
+    return crossings;
+    }
+
+int DiagramDependencyLayers::getNodeSpacing(size_t node) const
+    {
+    // Drawer nodes use the same spacing as the genes use for overlap.
+    // Dummy nodes only need room for the line.
+    int spacing = static_cast<int>(mNodeHeight / 2);
+    if(node < mNumDrawerNodes)
+        {
+        spacing = static_cast<int>(mNodeHeight * 1.5);
+        }
+    return spacing;
+    }
+
+void DiagramDependencyLayers::assignYPositions()
+    {
+    int topY = std::numeric_limits<int>::max();
+    for(size_t ni=0; ni<mNumDrawerNodes; ni++)
+        {
+        topY = std::min(topY, mDrawer->getNodePosition(ni).y);
+        }
+    // Start with the nodes packed in order in each layer.
+    mNodeYPositions.resize(mNodeLayers.size());
+    for(auto const &layerNodes : mLayerNodes)
+        {
+        int y = 0;
+        for(size_t node : layerNodes)
+            {
+            mNodeYPositions[node] = y;
+            y += getNodeSpacing(node);
+            }
+        }
+    for(int sweep=0; sweep<NumLayerSweeps; sweep++)
+        {
+        bool forward = (sweep % 2 == 0);
+        for(size_t i=1; i<mLayerNodes.size(); i++)
+            {
+            if(forward)
+                {
+                positionLayer(i, true);
+                }
+            else
+                {
+                positionLayer(mLayerNodes.size()-1-i, false);
+                }
+            }
+        }
+    // Move the top drawer node to the original top position.
+    int minY = std::numeric_limits<int>::max();
+    for(size_t ni=0; ni<mNumDrawerNodes; ni++)
+        {
+        minY = std::min(minY, mNodeYPositions[ni]);
+        }
+    for(int &y : mNodeYPositions)
+        {
+        y += topY - minY;
+        }
+    }
+
+void DiagramDependencyLayers::positionLayer(size_t layer, bool usePrevLayer)
+    {
+    std::vector<size_t> const &layerNodes = mLayerNodes[layer];
+    size_t numNodes = layerNodes.size();
+    std::vector<int> desiredY(numNodes);
+    for(size_t i=0; i<numNodes; i++)
+        {
+        size_t node = layerNodes[i];
+        std::vector<size_t> const &neighbors = usePrevLayer ?
+            mPrevNeighbors[node] : mNextNeighbors[node];
+        desiredY[i] = mNodeYPositions[node];
+        if(neighbors.size() > 0)
+            {
+            double total = 0;
+            for(size_t neighbor : neighbors)
+                {
+                total += mNodeYPositions[neighbor];
+                }
+            desiredY[i] = static_cast<int>(total / neighbors.size());
+            }
+        }
+    // Find positions that keep the spacing by pushing nodes down, and
+    // positions that keep the spacing by pushing nodes up. The average of
+    // the two keeps the spacing without moving the whole layer in one
+    // direction.
+    std::vector<int> downY(desiredY);
+    for(size_t i=1; i<numNodes; i++)
+        {
+        downY[i] = std::max(downY[i],
+            downY[i-1] + getNodeSpacing(layerNodes[i-1]));
+        }
+    std::vector<int> upY(desiredY);
+    for(size_t i=numNodes; i>1; i--)
+        {
+        upY[i-2] = std::min(upY[i-2],
+            upY[i-1] - getNodeSpacing(layerNodes[i-2]));
+        }
+    for(size_t i=0; i<numNodes; i++)
+        {
+        // Use floor so that negative positions round the same way.
+        mNodeYPositions[layerNodes[i]] = static_cast<int>(
+            floor((downY[i] + upY[i]) / 2.0));
+        }
+    }
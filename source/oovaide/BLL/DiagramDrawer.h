@@ -138,6 +138,9 @@ class DiagramDrawer
 class DiagramDependencyDrawer
     {
     public:
+        DiagramDependencyDrawer():
+            mLayeredLayout(false)
+            {}
         virtual size_t getNumNodes() const = 0;
         virtual void setNodePosition(size_t nodeIndex, GraphPoint pos) = 0;
         virtual GraphPoint getNodePosition(size_t nodeIndex) const = 0;
@@ -150,6 +153,10 @@ class DiagramDependencyDrawer
 
         GraphRect getNodeRect(DiagramDrawer &drawer, size_t nodeIndex) const;
         static const size_t NO_INDEX = static_cast<size_t>(-1);
+        /// If layered is true, the DiagramDependencyLayers are used to
+        /// position nodes, otherwise the DiagramDependencyGenes are used.
+        void setLayeredLayout(bool layered)
+            { mLayeredLayout = layered; }
 
     protected:
         size_t getNodeIndex(DiagramDrawer &drawer, GraphPoint p,
@@ -158,8 +165,14 @@ class DiagramDependencyDrawer
         /// This returns positions without the margin.
         std::vector<int> getColumnPositions(DiagramDrawer &drawer,
                 std::vector<size_t> const &depths) const;
+        /// Moves the nodes vertically within their columns. The X positions
+        /// of the nodes must already be set to the column positions.
+        void updateColumnNodePositions(size_t nodeHeight);
         void drawArrowDependency(DiagramDrawer &drawer,
                 GraphPoint &consumerPoint, GraphPoint &supplierPoint);
+
+    private:
+        bool mLayeredLayout;
     };
 
 class DistinctColors
@@ -199,4 +212,53 @@ class DiagramDependencyGenes:public GenePool
         bool nodesOverlap(size_t geneIndex, size_t node1, size_t node2) const;
     };
 
+/// This places the nodes of the include and portion diagrams using a layered
+/// (Sugiyama style) layout. Each column of nodes is a layer. Connections that
+/// cross more than one layer are split into dummy nodes so that all
+/// connections are between adjacent layers. The order of the nodes in each
+/// layer is found using barycenter sweeps to reduce line crossings, and then
+/// the Y positions are moved toward the connected nodes.
+/// This always produces the same layout for the same graph.
+class DiagramDependencyLayers
+    {
+    public:
+        DiagramDependencyLayers():
+            mDrawer(nullptr), mNodeHeight(0), mNumDrawerNodes(0)
+            {}
+        void initialize(DiagramDependencyDrawer &drawer, size_t nodeHeight);
+        /// Order and position the nodes in each layer, and move the positions
+        /// into the drawer.
+        void updatePositionsInDrawer();
+
+    private:
+        DiagramDependencyDrawer *mDrawer;
+        size_t mNodeHeight;
+        /// The nodes from the drawer are first, and are followed by the
+        /// dummy nodes.
+        size_t mNumDrawerNodes;
+        std::vector<size_t> mNodeLayers;
+        /// The index of each node within its layer.
+        std::vector<size_t> mNodeOrders;
+        std::vector<int> mNodeYPositions;
+        /// Connected nodes in the previous and next layers.
+        std::vector<std::vector<size_t>> mPrevNeighbors;
+        std::vector<std::vector<size_t>> mNextNeighbors;
+        /// The nodes in each layer in display order.
+        std::vector<std::vector<size_t>> mLayerNodes;
+
+        size_t addNode(size_t layer);
+        void addConnection(size_t prevNode, size_t nextNode);
+        void orderLayers();
+        /// Sorts a layer by the average order of the nodes in the
+        /// neighboring layer.
+        void orderLayerByBarycenter(size_t layer, bool usePrevLayer);
+        size_t countCrossings() const;
+        void assignYPositions();
+        /// Moves the nodes in the layer toward the average Y position of the
+        /// nodes in the neighboring layer without changing the order.
+        void positionLayer(size_t layer, bool usePrevLayer);
+        /// The minimum distance from the start of this node to the next node.
+        int getNodeSpacing(size_t node) const;
+    };
+
 #endif /* DIAGRAMDRAWER_H_ */
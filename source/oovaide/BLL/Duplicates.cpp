@@ -7,28 +7,11 @@
 #include "DirList.h"
 #include "Duplicates.h"
 #include "OovError.h"
-#include <memory.h>
+#include <string.h>
+#include <algorithm>
+#include <thread>
 
 
-/// This prevents output of duplicate comparisons. For example:
-/// File1         File2
-/// ..ABCD...    ..........ABCD...BCE.
-/// HashIndices
-///              ..........2345...34..
-///
-/// The comparison should not output: ABCD, BCD, CD, D,    BC, C
-class FilterOutputHashIndices
-    {
-    public:
-        void init(size_t size);
-        void markAlreadyOutput(size_t startIndexFile1, size_t len,
-            size_t startIndexFile2);
-        bool isAlreadyOutput(size_t startIndexFile1, size_t startIndexFile2);
-
-    private:
-        std::vector<size_t> mFile2HashIndices;
-    };
-
 class HashItem
     {
     public:
@@ -43,46 +26,27 @@ class HashFile
     {
     public:
         bool readHashFile(OovStringRef filePath);
-        void compareHashFiles(HashFile const &refFile,
-            FilterOutputHashIndices &outHashIndices,
-            DuplicateOptions const &options, std::vector<DuplicateLineInfo> &mDupLineInfo);
+        /// Makes a hash for every sequence of items that is the gram length.
+        /// Sequences that contain items without line numbers do not get a
+        /// gram and are set to zero.
+        void makeGramHashes(size_t gramLength);
+        size_t getNumItems() const
+            { return mHashItems.size(); }
+        HashItem const &getItem(size_t index) const
+            { return mHashItems[index]; }
+        /// Returns zero if there is no gram at the index.
+        size_t getGramHash(size_t index) const
+            { return mGramHashes[index]; }
+        OovString getRelativeFileName() const;
 
     private:
         OovString mFilePath;
         std::vector<HashItem> mHashItems;
+        std::vector<size_t> mGramHashes;
 
-        /// Returns the number of hash lines that match.
-        size_t getDupLinesLength(size_t thisStartIndex, HashFile const &refFile,
-            size_t refFileStartIndex);
         OovString getActualFileName() const;
-        OovString getRelativeFileName() const;
     };
 
-
-void FilterOutputHashIndices::init(size_t size)
-    {
-    if(size > mFile2HashIndices.size())
-        {
-        mFile2HashIndices.resize(size);
-        }
-    memset(&mFile2HashIndices[0], 0, size);
-    }
-
-void FilterOutputHashIndices::markAlreadyOutput(
-        size_t startIndexFile1, size_t len,
-    size_t startIndexFile2)
-    {
-    for(size_t i=0; i<len; i++)
-        {
-        mFile2HashIndices[startIndexFile2+i] = startIndexFile1+i;
-        }
-    }
-
-bool FilterOutputHashIndices::isAlreadyOutput(size_t startIndexFile1, size_t startIndexFile2)
-    {
-    return(mFile2HashIndices[startIndexFile2] == startIndexFile1);
-    }
-
 
 bool HashFile::readHashFile(OovStringRef const filePath)
     {
@@ -126,75 +90,40 @@ bool HashFile::readHashFile(OovStringRef const filePath)
     return(status.ok());
     }
 
-void HashFile::compareHashFiles(HashFile const &refFile,
-    FilterOutputHashIndices &outHashIndices, DuplicateOptions const &options,
-    std::vector<DuplicateLineInfo> &mDupLineInfo)
+void HashFile::makeGramHashes(size_t gramLength)
     {
-//    fprintf(outFile.getFp(), "Compare %s\n   %s\n", mFilePath.getStr(),
-//          refFile.mFilePath.getStr());
-    outHashIndices.init(refFile.mHashItems.size());
-    for(size_t i1=0; i1<mHashItems.size(); i1++)
+    // This is a polynomial rolling hash over the item hashes.
+    const size_t multiplier = 1000003;
+    size_t highMultiplier = 1;
+    for(size_t i=1; i<gramLength; i++)
         {
-        size_t i2=i1;
-        while(i2<refFile.mHashItems.size())
-            {
-            size_t inc=1;
-            bool samePlace = false;
-            if(options.mFindDupsInLines)
-                samePlace = ((this == &refFile) && (i1 == i2));
-            else
-                samePlace = ((this == &refFile) && mHashItems[i1].mLineNum == mHashItems[i2].mLineNum);
-            if(!samePlace)
-                {
-                inc = getDupLinesLength(i1, refFile, i2);
-                if(inc > options.mNumTokenMatches)
-                    {
-                    if(!outHashIndices.isAlreadyOutput(i1, i2))
-                        {
-                        outHashIndices.markAlreadyOutput(i1, inc, i2);
-                        size_t totalLines = (mHashItems[i1+inc-1].mLineNum - mHashItems[i1].mLineNum) + 1;
-                        DuplicateLineInfo info;
-                        info.mTotalDupLines = static_cast<int>(totalLines);
-                        info.mFile1 = getRelativeFileName().getStr();
-                        info.mFile1StartLine = static_cast<int>(mHashItems[i1].mLineNum);
-                        info.mFile2 = refFile.getRelativeFileName().getStr();
-                        info.mFile2StartLine = static_cast<int>(refFile.mHashItems[i2].mLineNum);
-                        mDupLineInfo.push_back(info);
-                        }
-                    }
-                else
-                    inc = 1;
-                }
-
-            i2 += inc;
-            }
+        highMultiplier *= multiplier;
         }
-    }
-
-size_t HashFile::getDupLinesLength(size_t thisStartIndex, HashFile const &refFile,
-    size_t refFileStartIndex)
-    {
-    size_t matchLen = 0;
-    while(mHashItems[thisStartIndex].mHash == refFile.mHashItems[refFileStartIndex].mHash)
+    mGramHashes.assign(mHashItems.size(), 0);
+    size_t gramHash = 0;
+    size_t numValid = 0;
+    for(size_t i=0; i<mHashItems.size(); i++)
         {
-        if(mHashItems[thisStartIndex].mLineNum == 0 ||
-                refFile.mHashItems[refFileStartIndex].mLineNum == 0)
+        if(i >= gramLength)
             {
-            break;
+            gramHash -= (mHashItems[i-gramLength].mHash + 1) * highMultiplier;
             }
-        if(thisStartIndex < mHashItems.size() &&
-                refFileStartIndex < refFile.mHashItems.size())
+        gramHash = gramHash * multiplier + mHashItems[i].mHash + 1;
+        if(mHashItems[i].mLineNum != 0)
             {
-            matchLen++;
-            thisStartIndex++;
-            refFileStartIndex++;
+            numValid++;
             }
         else
             {
-            break;
+            numValid = 0;
+            }
+        if(numValid >= gramLength)
+            {
+            size_t startIndex = i + 1 - gramLength;
+            // Zero is used to indicate that there is no gram.
+            mGramHashes[startIndex] = (gramHash != 0) ? gramHash : 1;
             }
         }
-    return matchLen;
     }
 
 OovString HashFile::getActualFileName() const
@@ -214,6 +143,60 @@ OovString HashFile::getRelativeFileName() const
     }
 
 
+/// The position of a gram in the hash files.
+class GramPos
+    {
+    public:
+        GramPos(size_t gramHash=0, size_t fileIndex=0, size_t itemIndex=0):
+            mGramHash(gramHash), mFileIndex(fileIndex), mItemIndex(itemIndex)
+            {}
+        bool operator<(GramPos const &pos) const
+            {
+            if(mGramHash != pos.mGramHash)
+                return(mGramHash < pos.mGramHash);
+            if(mFileIndex != pos.mFileIndex)
+                return(mFileIndex < pos.mFileIndex);
+            return(mItemIndex < pos.mItemIndex);
+            }
+        size_t mGramHash;
+        size_t mFileIndex;
+        size_t mItemIndex;
+    };
+
+/// A sequence of hash items that is duplicated. The position of the first
+/// file is always before the position of the second file.
+class DuplicateRun
+    {
+    public:
+        DuplicateRun(GramPos const &pos1, GramPos const &pos2, size_t len):
+            mFile1Index(pos1.mFileIndex), mFile1ItemIndex(pos1.mItemIndex),
+            mFile2Index(pos2.mFileIndex), mFile2ItemIndex(pos2.mItemIndex),
+            mLength(len)
+            {}
+        bool operator<(DuplicateRun const &run) const
+            {
+            if(mFile1Index != run.mFile1Index)
+                return(mFile1Index < run.mFile1Index);
+            if(mFile2Index != run.mFile2Index)
+                return(mFile2Index < run.mFile2Index);
+            if(mFile1ItemIndex != run.mFile1ItemIndex)
+                return(mFile1ItemIndex < run.mFile1ItemIndex);
+            return(mFile2ItemIndex < run.mFile2ItemIndex);
+            }
+        size_t mFile1Index;
+        size_t mFile1ItemIndex;
+        size_t mFile2Index;
+        size_t mFile2ItemIndex;
+        size_t mLength;
+    };
+
+/// This finds duplicates using an index of grams. Only positions that have
+/// the same gram hash are compared, and only the positions where a duplicate
+/// sequence starts are output. For example:
+/// File1         File2
+/// ..ABCD...    ..........ABCD...BCE.
+///
+/// The comparison outputs ABCD, but does not output BCD, CD, D or BC, C.
 class Duplicates
     {
     public:
@@ -224,8 +207,22 @@ class Duplicates
 
     private:
         std::vector<HashFile> mHashFiles;
-        // This is here to reduce the number of memory allocations.
-        FilterOutputHashIndices mFilterOutputHashIndices;
+
+        /// Finds the duplicates for the grams where the gram hash modulo the
+        /// number of threads is the thread index.
+        void findDuplicates(DuplicateOptions const &options, size_t threadIndex,
+            size_t numThreads, std::vector<DuplicateRun> &runs) const;
+        /// Both positions must be valid items that match, and the positions
+        /// must not be in the same place.
+        bool isMatch(GramPos const &pos1, GramPos const &pos2) const;
+        bool isSamePlace(DuplicateOptions const &options, GramPos const &pos1,
+            GramPos const &pos2) const;
+        /// Returns true if the previous items are not part of a duplicate
+        /// sequence that was already found.
+        bool isStartOfDuplicate(DuplicateOptions const &options,
+            GramPos const &pos1, GramPos const &pos2) const;
+        /// Returns the number of hash items that match.
+        size_t getDupLength(GramPos const &pos1, GramPos const &pos2) const;
     };
 
 
@@ -238,16 +235,177 @@ Duplicates::Duplicates(std::vector<std::string> const &filePaths):
         }
     }
 
+bool Duplicates::isSamePlace(DuplicateOptions const &options,
+        GramPos const &pos1, GramPos const &pos2) const
+    {
+    bool samePlace = false;
+    if(pos1.mFileIndex == pos2.mFileIndex)
+        {
+        if(options.mFindDupsInLines)
+            {
+            samePlace = (pos1.mItemIndex == pos2.mItemIndex);
+            }
+        else
+            {
+            HashFile const &file = mHashFiles[pos1.mFileIndex];
+            samePlace = (file.getItem(pos1.mItemIndex).mLineNum ==
+                file.getItem(pos2.mItemIndex).mLineNum);
+            }
+        }
+    return samePlace;
+    }
+
+bool Duplicates::isMatch(GramPos const &pos1, GramPos const &pos2) const
+    {
+    HashItem const &item1 = mHashFiles[pos1.mFileIndex].getItem(pos1.mItemIndex);
+    HashItem const &item2 = mHashFiles[pos2.mFileIndex].getItem(pos2.mItemIndex);
+    return(item1.mLineNum != 0 && item2.mLineNum != 0 &&
+        item1.mHash == item2.mHash);
+    }
+
+bool Duplicates::isStartOfDuplicate(DuplicateOptions const &options,
+        GramPos const &pos1, GramPos const &pos2) const
+    {
+    bool start = true;
+    GramPos prev1 = pos1;
+    GramPos prev2 = pos2;
+    // A sequence can continue through items in the same place, but cannot
+    // start there, so skip back over them.
+    while(start && prev1.mItemIndex > 0 && prev2.mItemIndex > 0)
+        {
+        prev1.mItemIndex--;
+        prev2.mItemIndex--;
+        if(!isMatch(prev1, prev2))
+            {
+            break;
+            }
+        if(!isSamePlace(options, prev1, prev2))
+            {
+            start = false;
+            }
+        }
+    return start;
+    }
+
+size_t Duplicates::getDupLength(GramPos const &pos1, GramPos const &pos2) const
+    {
+    HashFile const &file1 = mHashFiles[pos1.mFileIndex];
+    HashFile const &file2 = mHashFiles[pos2.mFileIndex];
+    size_t matchLen = 0;
+    size_t index1 = pos1.mItemIndex;
+    size_t index2 = pos2.mItemIndex;
+    while(index1 < file1.getNumItems() && index2 < file2.getNumItems())
+        {
+        HashItem const &item1 = file1.getItem(index1);
+        HashItem const &item2 = file2.getItem(index2);
+        if(item1.mLineNum == 0 || item2.mLineNum == 0 ||
+                item1.mHash != item2.mHash)
+            {
+            break;
+            }
+        matchLen++;
+        index1++;
+        index2++;
+        }
+    return matchLen;
+    }
+
+void Duplicates::findDuplicates(DuplicateOptions const &options,
+        size_t threadIndex, size_t numThreads, std::vector<DuplicateRun> &runs) const
+    {
+    std::vector<GramPos> grams;
+    for(size_t fi=0; fi<mHashFiles.size(); fi++)
+        {
+        HashFile const &file = mHashFiles[fi];
+        for(size_t ii=0; ii<file.getNumItems(); ii++)
+            {
+            size_t gramHash = file.getGramHash(ii);
+            if(gramHash != 0 && gramHash % numThreads == threadIndex)
+                {
+                grams.push_back(GramPos(gramHash, fi, ii));
+                }
+            }
+        }
+    std::sort(grams.begin(), grams.end());
+    size_t groupStart = 0;
+    while(groupStart < grams.size())
+        {
+        size_t groupEnd = groupStart + 1;
+        while(groupEnd < grams.size() &&
+                grams[groupEnd].mGramHash == grams[groupStart].mGramHash)
+            {
+            groupEnd++;
+            }
+        // The grams are sorted by position, so the first position is
+        // always before the second position.
+        for(size_t g1=groupStart; g1<groupEnd; g1++)
+            {
+            for(size_t g2=g1+1; g2<groupEnd; g2++)
+                {
+                GramPos const &pos1 = grams[g1];
+                GramPos const &pos2 = grams[g2];
+                if(!isSamePlace(options, pos1, pos2) &&
+                        isStartOfDuplicate(options, pos1, pos2))
+                    {
+                    // The length must be checked since different grams can
+                    // have the same hash.
+                    size_t len = getDupLength(pos1, pos2);
+                    if(len > options.mNumTokenMatches)
+                        {
+                        runs.push_back(DuplicateRun(pos1, pos2, len));
+                        }
+                    }
+                }
+            }
+        groupStart = groupEnd;
+        }
+    }
+
 void Duplicates::compareAllFiles(DuplicateOptions const &options,
         std::vector<DuplicateLineInfo> &dupLineInfo)
     {
-    for(size_t i1=0; i1<mHashFiles.size(); i1++)
+    size_t numThreads = std::thread::hardware_concurrency();
+    if(numThreads == 0)
         {
-        for(size_t i2=i1; i2<mHashFiles.size(); i2++)
-            {
-            mHashFiles[i1].compareHashFiles(mHashFiles[i2],
-                mFilterOutputHashIndices, options, dupLineInfo);
-            }
+        numThreads = 1;
+        }
+    for(auto &file : mHashFiles)
+        {
+        file.makeGramHashes(options.mNumTokenMatches + 1);
+        }
+    std::vector<std::vector<DuplicateRun>> threadRuns(numThreads);
+    std::vector<std::thread> threads;
+    for(size_t ti=0; ti<numThreads; ti++)
+        {
+        threads.push_back(std::thread([this, &options, ti, numThreads, &threadRuns]()
+            { findDuplicates(options, ti, numThreads, threadRuns[ti]); }));
+        }
+    std::vector<DuplicateRun> runs;
+    for(size_t ti=0; ti<numThreads; ti++)
+        {
+        threads[ti].join();
+        runs.insert(runs.end(), threadRuns[ti].begin(), threadRuns[ti].end());
+        }
+    // Output in the same order as comparing each pair of files.
+    std::sort(runs.begin(), runs.end());
+    std::vector<OovString> relFileNames;
+    for(auto const &file : mHashFiles)
+        {
+        relFileNames.push_back(file.getRelativeFileName());
+        }
+    for(auto const &run : runs)
+        {
+        HashFile const &file1 = mHashFiles[run.mFile1Index];
+        HashFile const &file2 = mHashFiles[run.mFile2Index];
+        HashItem const &startItem = file1.getItem(run.mFile1ItemIndex);
+        HashItem const &endItem = file1.getItem(run.mFile1ItemIndex + run.mLength - 1);
+        DuplicateLineInfo info;
+        info.mTotalDupLines = static_cast<int>(endItem.mLineNum - startItem.mLineNum + 1);
+        info.mFile1 = relFileNames[run.mFile1Index];
+        info.mFile1StartLine = static_cast<int>(startItem.mLineNum);
+        info.mFile2 = relFileNames[run.mFile2Index];
+        info.mFile2StartLine = static_cast<int>(file2.getItem(run.mFile2ItemIndex).mLineNum);
+        dupLineInfo.push_back(info);
         }
     }
 
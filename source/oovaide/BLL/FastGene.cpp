@@ -6,20 +6,51 @@
 #include <malloc.h>
 #include <math.h>
 #include <ctype.h>
-#include <random>
 #include <float.h>      // For DBL_MAX
+#include <algorithm>
+#include <thread>
 
-/// Generate a random number including 0 to maxpossible
-static size_t randmax(size_t maxpossible)
+const size_t GenePool::NumGeneRanges;
+
+size_t GenePool::randMax(size_t rangeIndex, size_t maxpossible)
     {
-    static std::default_random_engine generator;
     std::uniform_int_distribution<size_t> distribution(0, maxpossible);
-    return distribution(generator);
+    return distribution(mRandomStreams[rangeIndex]);
+    }
+
+GeneValue GenePool::randRange(size_t rangeIndex, size_t min, size_t max)
+    {
+    return(static_cast<GeneValue>(randMax(rangeIndex, max-min)+min));
     }
 
-GeneValue GenePool::randRange(size_t min, size_t max)
+void GenePool::processGeneRanges(GeneRangeFunc const &func)
     {
-    return(static_cast<GeneValue>(randmax(max-min)+min));
+    size_t numThreads = std::min<size_t>(std::thread::hardware_concurrency(),
+        std::min(numgenes, NumGeneRanges));
+    if(numThreads == 0)
+        {
+        numThreads = 1;
+        }
+    // Each thread processes every numThreads range, and each range is
+    // processed by only one thread.
+    auto processRanges = [this, &func, numThreads](size_t threadIndex)
+        {
+        for(size_t ri=threadIndex; ri<NumGeneRanges; ri+=numThreads)
+            {
+            func(ri, numgenes * ri / NumGeneRanges,
+                numgenes * (ri+1) / NumGeneRanges);
+            }
+        };
+    std::vector<std::thread> threads;
+    for(size_t ti=1; ti<numThreads; ti++)
+        {
+        threads.push_back(std::thread(processRanges, ti));
+        }
+    processRanges(0);
+    for(auto &thread : threads)
+        {
+        thread.join();
+        }
     }
 
 void GenePool::initialize(size_t genebytes, size_t numberofgenes, double crossoverrate,
@@ -47,24 +78,34 @@ void GenePool::initialize(size_t genebytes, size_t numberofgenes, double crossov
     bestgenes.resize(numbestgenes);
     worstgenes.resize(numbestgenes);
 
+    mRandomStreams.clear();
+    for(size_t ri=0; ri<NumGeneRanges; ri++)
+        {
+        std::seed_seq seq = { mSeed, static_cast<unsigned int>(ri) };
+        mRandomStreams.push_back(GeneRandomEngine(seq));
+        }
+
     // Initialize the genes with random data
-    for(size_t i=0; i<numgenes; i++)
-        randomizeGene(i);
+    processGeneRanges([this](size_t rangeIndex, size_t startGene, size_t endGene)
+        {
+        for(size_t i=startGene; i<endGene; i++)
+            randomizeGene(rangeIndex, i);
+        });
     }
 
 
-void GenePool::randomizeGene(size_t index)
+void GenePool::randomizeGene(size_t rangeIndex, size_t index)
         {
         for(size_t i=0; i<genesize; i+=sizeof(GeneValue))
             {
-            randomizeGeneValue(index, i);
+            randomizeGeneValue(rangeIndex, index, i);
             }
         }
 
-void GenePool::randomizeGeneValue(size_t index, size_t offset)
+void GenePool::randomizeGeneValue(size_t rangeIndex, size_t index, size_t offset)
     {
     offset = geneValueBoundary(offset);
-    GeneValue val = randRange(min, max);
+    GeneValue val = randRange(rangeIndex, min, max);
     setValue(index, offset, val);
     }
 
@@ -83,10 +124,13 @@ void GenePool::singleGeneration()
 void GenePool::computeQuality()
     {
     setupQualityEachGeneration();
-    for(size_t i=0; i<numgenes; i++)
+    processGeneRanges([this](size_t /*rangeIndex*/, size_t startGene, size_t endGene)
         {
-        setGeneQuality(i, calculateSingleGeneQuality(i));
-        }
+        for(size_t i=startGene; i<endGene; i++)
+            {
+            setGeneQuality(i, calculateSingleGeneQuality(i));
+            }
+        });
     }
 
 void GenePool::getQualityHistogram(QualityHistogram &qualities) const
@@ -172,14 +216,14 @@ void GenePool::crossover()
     size_t genesRemaining = bestgenes.size();
     size_t dstgene = 0;
     // Each time, take 2 good source genes, cross them, and put them
-    // into the 2 worst genes.
+    // into the 2 worst genes. This is fast, so it only uses the first stream.
     while(genesRemaining)
         {
-        size_t splitpos = geneValueBoundary(randmax(
+        size_t splitpos = geneValueBoundary(randMax(0,
             static_cast<size_t>(genesize-1)));
-        size_t srcgene1 = randmax(
+        size_t srcgene1 = randMax(0,
             static_cast<size_t>(genesRemaining - 1));
-        size_t srcgene2 = randmax(
+        size_t srcgene2 = randMax(0,
             static_cast<size_t>(genesRemaining - 2));
         if (srcgene1 == srcgene2)
             {
@@ -216,26 +260,32 @@ void GenePool::crossover()
 
 void GenePool::mutate()
     {
-    size_t totalbytes = genesize * numgenes;
-    size_t mutebits = static_cast<size_t>((muterate * 8) * totalbytes);
-    for(size_t i = 0; i < mutebits; i++)
+    // Each range mutates only its own genes, so the ranges can be
+    // mutated at the same time.
+    processGeneRanges([this](size_t rangeIndex, size_t startGene, size_t endGene)
         {
-        // Get the offset of a byte in any portion of any gene
-        size_t gene = randmax(numgenes-1);
-        size_t offset = randmax(genesize-1);
-        randomizeGeneValue(gene, offset);
-
-        /*
-         // Get the address of a byte in any portion of any gene
-         byteaddr = genes + (sizeof(GeneHeader) + genesize) *
-         randmax(numgenes) + randmax(genesize) + sizeof(GeneHeader);
-
-         // Invert one bit in the byte
-         newval = (unsigned char)(*byteaddr ^ (1 << randmax(8)));
-         if(newval >= min && newval <= max)
-         *byteaddr = newval;
-         */
-        }
+        size_t numRangeGenes = endGene - startGene;
+        size_t totalbytes = genesize * numRangeGenes;
+        size_t mutebits = static_cast<size_t>((muterate * 8) * totalbytes);
+        for(size_t i = 0; i < mutebits; i++)
+            {
+            // Get the offset of a byte in any portion of any gene in the range
+            size_t gene = startGene + randMax(rangeIndex, numRangeGenes-1);
+            size_t offset = randMax(rangeIndex, genesize-1);
+            randomizeGeneValue(rangeIndex, gene, offset);
+
+            /*
+             // Get the address of a byte in any portion of any gene
+             byteaddr = genes + (sizeof(GeneHeader) + genesize) *
+             randmax(numgenes) + randmax(genesize) + sizeof(GeneHeader);
+
+             // Invert one bit in the byte
+             newval = (unsigned char)(*byteaddr ^ (1 << randmax(8)));
+             if(newval >= min && newval <= max)
+             *byteaddr = newval;
+             */
+            }
+        });
     }
 
 size_t GenePool::getBestGeneIndex()
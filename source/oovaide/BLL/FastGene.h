@@ -12,6 +12,8 @@
 #define FASTGENE_H
 
 #include <vector>
+#include <functional>
+#include <random>
 #include <stdint.h>
 #include <memory.h>
 
@@ -23,6 +25,7 @@ typedef uint8_t GeneByteValue;
 typedef GeneByteValue *GenePtr;         // A pointer to gene strings
 typedef const GeneByteValue *ConstGenePtr;      // A pointer to gene strings
 typedef std::vector<QualityType> QualityHistogram;
+typedef std::default_random_engine GeneRandomEngine;
 
 
 /// This class holds the data for a genetic algorithm.
@@ -40,6 +43,18 @@ class GenePool
         std::vector<GenePtr> worstgenes;        /// List of bad genes to overwrite
         GeneValue min;                  /// Minimum gene value
         GeneValue max;
+        unsigned int mSeed;             /// Seed for all random streams
+        /// One random stream for each gene range.
+        std::vector<GeneRandomEngine> mRandomStreams;
+
+        /// The genes are split into a fixed number of ranges that are
+        /// processed by worker threads. Each range uses its own random stream,
+        /// so the results for a seed do not depend on the number of threads.
+        static const size_t NumGeneRanges = 16;
+        typedef std::function<void(size_t rangeIndex, size_t startGene,
+            size_t endGene)> GeneRangeFunc;
+        /// Calls the function for every gene range, using multiple threads.
+        void processGeneRanges(GeneRangeFunc const &func);
 
         /// This fills the quality value in all of the genes.
         void computeQuality();
@@ -52,7 +67,7 @@ class GenePool
         void buildBestWorstList();
 
         GenePool():
-            numgenes(0), genesize(0), muterate(.1), min(0), max(0)
+            numgenes(0), genesize(0), muterate(.1), min(0), max(0), mSeed(1)
             {}
         virtual ~GenePool()
             {}
@@ -69,17 +84,26 @@ class GenePool
             {}
         /// This function is called for every gene. It is passed the gene to
         /// test and returns the quality of the gene.
+        /// This is called from multiple threads at the same time, so it must
+        /// not modify any data.
         virtual QualityType calculateSingleGeneQuality(size_t geneIndex) const = 0;
-        virtual void randomizeGene(size_t geneIndex);
+        virtual void randomizeGene(size_t rangeIndex, size_t geneIndex);
         /// Offset is byte based.
-        virtual void randomizeGeneValue(size_t geneIndex, size_t offset);
+        virtual void randomizeGeneValue(size_t rangeIndex, size_t geneIndex,
+            size_t offset);
+        /// Generate a random number including 0 to maxpossible
+        size_t randMax(size_t rangeIndex, size_t maxpossible);
         /// Generate a random number between and including the min and max
-        static GeneValue randRange(size_t min, size_t max);
+        GeneValue randRange(size_t rangeIndex, size_t min, size_t max);
         // Convert the input offset so that it fits on a gene value boundary.
         size_t geneValueBoundary(size_t offset)
             { return(offset / sizeof(GeneValue) * sizeof(GeneValue)); }
 
     public:
+        /// The seed must be set before initialize is called. The same seed
+        /// will produce the same genes.
+        void setSeed(unsigned int seed)
+            { mSeed = seed; }
         /// Do one generation of evolution for the geen pool.
         void singleGeneration();
         size_t getNumGenes() const
@@ -27,6 +27,9 @@ class IncludeDiagram:public Diagram
             {
             mIncludeDrawer.updateGraph(drawer, mIncludeGraph);
             }
+        /// See DiagramDependencyDrawer::setLayeredLayout.
+        void setLayeredLayout(bool layered)
+            { mIncludeDrawer.setLayeredLayout(layered); }
 
         size_t getNodeIndex(DiagramDrawer &drawer, GraphPoint p) const
             { return mIncludeDrawer.getNodeIndex(drawer, p); }
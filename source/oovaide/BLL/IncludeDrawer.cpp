@@ -103,10 +103,8 @@ void IncludeDrawer::updateNodePositions(DiagramDrawer &drawer)
         }
     if(mNodePositions.size() > 0)
         {
-        DiagramDependencyGenes genes;
         GraphRect rect = getNodeRect(drawer, 0);
-        genes.initialize(*this, static_cast<size_t>(rect.size.y));
-        genes.updatePositionsInDrawer();
+        updateColumnNodePositions(static_cast<size_t>(rect.size.y));
         }
     }
 
@@ -33,13 +33,10 @@ void IncludeGraph::clearAndAddInclude(OovStringRef incName)
 size_t IncludeGraph::getNodeIndex(OovStringRef name) const
     {
     size_t nodeIndex = NO_INDEX;
-    for(size_t i=0; i<mNodes.size(); i++)
+    auto const &iter = mNodeIndices.find(name);
+    if(iter != mNodeIndices.end())
         {
-        if(mNodes[i].getName().compare(name) == 0)
-            {
-            nodeIndex = i;
-            break;
-            }
+        nodeIndex = (*iter).second;
         }
     return nodeIndex;
     }
@@ -48,6 +45,7 @@ void IncludeGraph::addNode(OovStringRef name)
     {
     if(getNodeIndex(name) == NO_INDEX)
         {
+        mNodeIndices[name] = mNodes.size();
         mNodes.push_back(IncludeNode(name, INT_Project));
         }
     }
@@ -58,6 +56,11 @@ void IncludeGraph::removeNode(OovStringRef name)
     if(index != NO_INDEX)
         {
         mNodes.erase(mNodes.begin() + index);
+        mNodeIndices.clear();
+        for(size_t i=0; i<mNodes.size(); i++)
+            {
+            mNodeIndices[mNodes[i].getName()] = i;
+            }
         }
     updateConnections();
     }
@@ -65,7 +68,7 @@ void IncludeGraph::removeNode(OovStringRef name)
 void IncludeGraph::addSuppliers(OovStringRef consName)
     {
     std::set<IncludedPath> incFiles;
-    mIncludeMap->getImmediateIncludeFilesUsedBySourceFile(consName, incFiles);
+    mIncludeMap->getDirectIncludeFiles(consName, incFiles);
     addNode(consName);
     for(auto const &incFile : incFiles)
         {
@@ -77,19 +80,11 @@ void IncludeGraph::addSuppliers(OovStringRef consName)
 void IncludeGraph::addConsumers(OovStringRef incName)
     {
     addNode(incName);
-    for(auto const &consFile : mIncludeMap->getNameValues())
+    OovStringSet consFiles;
+    mIncludeMap->getDirectIncluders(incName, consFiles);
+    for(auto const &consFile : consFiles)
         {
-        std::set<IncludedPath> supFiles;
-        mIncludeMap->getImmediateIncludeFilesUsedBySourceFile(
-            consFile.first, supFiles);
-        for(auto const &supFile : supFiles)
-            {
-            if(supFile.getFullPath().compare(incName) == 0)
-                {
-                addNode(consFile.first);
-                break;
-                }
-            }
+        addNode(consFile);
         }
     updateConnections();
     }
@@ -100,11 +95,10 @@ void IncludeGraph::updateConnections()
     for(auto const &consNode : mNodes)
         {
         std::set<IncludedPath> incFiles;
-        mIncludeMap->getImmediateIncludeFilesUsedBySourceFile(
-            consNode.getName(), incFiles);
+        mIncludeMap->getDirectIncludeFiles(consNode.getName(), incFiles);
+        size_t consIndex = getNodeIndex(consNode.getName());
         for(auto const &supNode : incFiles)
             {
-            size_t consIndex = getNodeIndex(consNode.getName());
             size_t supIndex = getNodeIndex(supNode.getFullPath());
             if(supIndex != NO_INDEX && consIndex != NO_INDEX)
                 {
@@ -61,6 +61,7 @@ class IncludeGraph
         void clearGraph()
             {
             mNodes.clear();
+            mNodeIndices.clear();
             mConnections.clear();
             }
         // The source must exist for the lifetime of the graph.
@@ -85,6 +86,8 @@ class IncludeGraph
 
     private:
         std::vector<IncludeNode> mNodes;
+        /// The index into mNodes for each node name.
+        std::map<OovString, size_t> mNodeIndices;
         IncludeConnections mConnections;
         const IncDirDependencyMapReader *mIncludeMap;
         IncludeDrawOptions mDrawOptions;
@@ -597,39 +597,23 @@ void OperationGraph::addOperDefinition(const OperationCall &opcall)
         }
     }
 
-void OperationGraph::addOperCallers(const ModelStatements &stmts,
-        const ModelClassifier &srcCls, const ModelOperation &oper,
-        const OperationCall &callee)
+void OperationGraph::addOperCallers(const ModelData &model, const OperationCall &callee)
     {
     OperationClass const *calleeClass = callee.getDestNode()->getClass();
     if(calleeClass)
         {
-        for(auto const &stmt : stmts)
-            {
-            if(stmt.getStatementType() == ST_Call)
-                {
-                const ModelClassifier *callerCls = ModelClassifier::getClass(
-                    stmt.getClassDecl().getDeclType());
-                if(stmt.operMatch(callee.getOperation().getName()) &&
-                        callerCls == calleeClass->getType())
-                    {
-                    addRelatedOperations(srcCls, oper, OperationGraph::AO_All, 1);
-                    }
-                }
-            }
-        }
-    }
-
-void OperationGraph::addOperCallers(const ModelData &model, const OperationCall &callee)
-    {
-    for(const auto &type : model.mTypes)
-        {
-        const ModelClassifier *srcCls = ModelClassifier::getClass(type.get());
-        if(srcCls)
-            {
-            for(const auto &oper : srcCls->getOperations())
+        const ModelClassifier *calleeCls = ModelClassifier::getClass(
+            calleeClass->getType());
+        if(calleeCls)
+            {
+            // The model has an index of the callers of each operation.
+            std::vector<ModelOperationCaller> callers;
+            model.getOperationCallers(*calleeCls, callee.getOperation().getName(),
+                callers);
+            for(auto const &caller : callers)
                 {
-                addOperCallers(oper->getStatements(), *srcCls, *oper, callee);
+                addRelatedOperations(*caller.mClassifier, *caller.mOperation,
+                    OperationGraph::AO_All, 1);
                 }
             }
         }
@@ -323,8 +323,6 @@ class OperationGraph
         static const size_t NO_INDEX = static_cast<size_t>(-1);
 
         void addDefinition(OperationNode const *destNode, ModelOperation const &oper);
-        void addOperCallers(ModelStatements const &stmts, ModelClassifier const &srcCls,
-                ModelOperation const &oper, OperationCall const &callee);
         enum eGetClass { GC_AddClasses, FT_OnlyGetClasses };
         size_t addOrGetClass(ModelClassifier const *cls, eGetClass gc);
         size_t addOrGetVariable(ModelClassifier const *cls, OovStringRef varName,
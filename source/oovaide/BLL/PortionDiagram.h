@@ -22,6 +22,9 @@ class PortionDiagram:public Diagram
             {
             mPortionDrawer.updateNodePositions(drawer);
             }
+        /// See DiagramDependencyDrawer::setLayeredLayout.
+        void setLayeredLayout(bool layered)
+            { mPortionDrawer.setLayeredLayout(layered); }
         GraphSize getDrawingSize(DiagramDrawer &drawer)
             { return mPortionDrawer.getDrawingSize(drawer); }
         OovStringRef getCurrentClassName() const
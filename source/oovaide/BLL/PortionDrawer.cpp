@@ -86,10 +86,8 @@ void PortionDrawer::updateNodePositions(DiagramDrawer &drawer)
 #if(PORTION_GENES)
     if(mNodePositions.size() > 0)
         {
-        DiagramDependencyGenes genes;
         GraphRect rect = getNodeRect(drawer, 0);
-        genes.initialize(*this, static_cast<size_t>(rect.size.y));
-        genes.updatePositionsInDrawer();
+        updateColumnNodePositions(static_cast<size_t>(rect.size.y));
         }
 #endif
     }
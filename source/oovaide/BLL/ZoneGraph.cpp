@@ -6,6 +6,7 @@
 
 #include "ZoneGraph.h"
 #include <algorithm>
+#include <unordered_map>
 #include "Project.h"
 
 static bool isFiltered(ModelModule const *module,
@@ -64,12 +65,13 @@ static const size_t NO_INDEX = static_cast<size_t>(-1);
 class ReverseIndexLookup
     {
     public:
-        ReverseIndexLookup(std::vector<ZoneNode> const &nodes):
-            mClasses(nodes.size())
+        ReverseIndexLookup(std::vector<ZoneNode> const &nodes)
             {
+            mClassIndices.reserve(nodes.size());
             for(size_t i=0; i<nodes.size(); i++)
                 {
-                mClasses[i] = ModelClassifier::getClass(nodes[i].mType);
+                mClassIndices.insert(std::make_pair(
+                    ModelClassifier::getClass(nodes[i].mType), i));
                 }
             }
 
@@ -77,20 +79,16 @@ class ReverseIndexLookup
         size_t getClassIndex(const ModelClassifier *classifier) const
             {
             size_t index = NO_INDEX;
-            for(size_t i=0; i<mClasses.size(); i++)
+            auto const &iter = mClassIndices.find(classifier);
+            if(iter != mClassIndices.end())
                 {
-                if(mClasses[i] == classifier)
-                    {
-                    index = i;
-                    break;
-                    }
+                index = (*iter).second;
                 }
             return index;
             }
 
     private:
-        /// @todo - could use a map or something here.
-        std::vector<const ModelClassifier*> mClasses;
+        std::unordered_map<const ModelClassifier*, size_t> mClassIndices;
     };
 
 void ZoneConnections::insertConnection(size_t nodeIndex1, size_t nodeIndex2,
@@ -234,6 +232,7 @@ void ZoneGraph::updateConnections()
     {
     bool drawFuncRels = mDrawOptions.mDrawFunctionRelations;
     ReverseIndexLookup indexLookup(getNodes());
+    std::vector<ModelAssociation const *> assocs;
     mConnections.clear();
     for(size_t nodeIndex=0; nodeIndex<getNodes().size(); nodeIndex++)
         {
@@ -267,8 +266,10 @@ void ZoneGraph::updateConnections()
                     }
                 }
 
-            // Go through associations, and get related classes.
-            for(const auto &assoc : mModel->mAssociations)
+            // Go through associations, and get related classes. The model
+            // has an index of the associations for each class.
+            mModel->getAssociations(*classifier, assocs);
+            for(const auto &assoc : assocs)
                 {
                 size_t n1Index = NO_INDEX;
                 size_t n2Index = NO_INDEX;
@@ -29,6 +29,7 @@ static const ClassDrawOptions &getDrawOptions(GuiOptions const &guiOptions)
     dopts.drawOperParamRelations = guiOptions.getValueBool(OptGuiShowOperParamRelations);
     dopts.drawOperBodyVarRelations = guiOptions.getValueBool(OptGuiShowOperBodyVarRelations);
     dopts.drawRelationKey = guiOptions.getValueBool(OptGuiShowRelationKey);
+    dopts.forceLayout = guiOptions.getValueBool(OptGuiForceClassLayout);
     return dopts;
     }
 
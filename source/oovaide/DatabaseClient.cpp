@@ -10,6 +10,28 @@
 #include "Components.h"
 #include "BuildConfigReader.h"
 #include "IncludeMap.h"
+#include <chrono>
+
+/// Returns the number of types to write in the next transaction. Larger
+/// transactions are faster, but the progress dialog is only updated between
+/// transactions, so the size is adjusted to keep each call near the
+/// target time.
+/// @param typesPerTransaction The number of types in the last transaction.
+/// @param elapsedMs The time that the last transaction took.
+static int getAdaptiveTypesPerTransaction(int typesPerTransaction, int elapsedMs)
+    {
+    const int TargetMs = 150;
+    const int MaxTypesPerTransaction = 100000;
+    if(elapsedMs < TargetMs / 2 && typesPerTransaction < MaxTypesPerTransaction)
+        {
+        typesPerTransaction *= 2;
+        }
+    else if(elapsedMs > TargetMs * 2 && typesPerTransaction > 1)
+        {
+        typesPerTransaction /= 2;
+        }
+    return typesPerTransaction;
+    }
 
 void DatabaseWriter::writeDatabase(ProjectReader &project, ModelData *modelData)
     {
@@ -35,6 +57,7 @@ void DatabaseWriter::writeDatabase(ProjectReader &project, ModelData *modelData)
             progressDlg.setParentWindow(Gui::getMainWindow());
             bool keepGoing = true;
             size_t totalTypes = modelData->mTypes.size();
+            int typesPerTransaction = 40;
             for(int pass=0; pass<2 && success && keepGoing; pass++)
                 {
                 int typeIndex = 0;
@@ -44,9 +67,14 @@ void DatabaseWriter::writeDatabase(ProjectReader &project, ModelData *modelData)
                 progressDlg.startTask(str.getStr(), totalTypes);
                 while(typeIndex < static_cast<int>(totalTypes) && success && keepGoing)
                     {
-                    success = WriteDb(pass, typeIndex, 40);
+                    auto startTime = std::chrono::steady_clock::now();
+                    success = WriteDb(pass, typeIndex, typesPerTransaction);
                     if(success)
                         {
+                        auto elapsed = std::chrono::steady_clock::now() - startTime;
+                        typesPerTransaction = getAdaptiveTypesPerTransaction(
+                            typesPerTransaction, static_cast<int>(std::chrono::
+                            duration_cast<std::chrono::milliseconds>(elapsed).count()));
                         keepGoing = progressDlg.updateProgressIteration(typeIndex, nullptr, true);
                         typeIndex++;
                         }
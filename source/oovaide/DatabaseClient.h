@@ -24,6 +24,9 @@ struct DatabaseWriterInterface
     ///         type information and methods. The second pass looks at
     ///         each methods statements to find related types and methods.
     /// *param typeIndex The index of the type to save from ModelData::mTypes.
+    ///         This is set to the index of the last type that was written.
+    /// @param maxTypesPerTransaction The number of types to write in one
+    ///         transaction.
     bool (*WriteDb)(int passIndex, int &typeIndex, int maxTypesPerTransaction);
     /// This writes the component information that is used by the modules table.
     bool (*WriteDbComponentTypes)(void const *compTypesFile, void const *scannedCompInfo);
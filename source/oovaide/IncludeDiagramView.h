@@ -21,6 +21,8 @@ class IncludeDiagramView
             {}
         void initialize(IncDirDependencyMapReader const &incMap)
             {
+            mIncludeDiagram.setLayeredLayout(mGuiOptions.getValueBool(
+                OptGuiLayeredDependencyLayout));
             mIncludeDiagram.initialize(incMap);
             restart();
             }
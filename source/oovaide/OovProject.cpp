@@ -228,31 +228,31 @@ void OovProject::processAnalysisFiles()
             {
             taskId = mStatusListener->startTask("Loading files.", fileNames.size());
             }
+        // The files are parsed into separate models by the worker threads,
+        // and then merged in file order so that the type indices are the
+        // same as if the files were loaded one at a time.
+        XmiFileModelLoader loader(fileNames);
+        loader.setupQueue(XmiFileModelLoader::getNumHardwareThreads());
+        size_t numQueued = 0;
         // The continueProcessingItem is from the ThreadedWorkBackgroundQueue,
         // and is set false when stopAndWaitForCompletion() is called.
-        for(size_t i=0; i<fileNames.size() && continueProcessingItem(); i++)
+        for(; numQueued<fileNames.size() && continueProcessingItem(); numQueued++)
             {
             OovString fileText = "File ";
-            fileText.appendInt(i);
+            fileText.appendInt(numQueued);
             fileText += ": ";
-            fileText += fileNames[i];
+            fileText += fileNames[numQueued];
             if(mStatusListener && !mStatusListener->updateProgressIteration(
-                    taskId, i, fileText))
+                    taskId, numQueued, fileText))
                 {
                 break;
                 }
-            File file;
-            OovStatus status = file.open(fileNames[i], "r");
-            if(status.ok())
-                {
-                loadXmiFile(file, mModelData, fileNames[i], typeIndex);
-                }
-            if(status.needReport())
-                {
-                OovString err = "Unable to read XMI file ";
-                err += fileNames[i];
-                status.report(ET_Error, err);
-                }
+            loader.addTask(numQueued);
+            }
+        loader.waitForCompletion();
+        for(size_t i=0; i<numQueued && continueProcessingItem(); i++)
+            {
+            loader.getFileModel(i).merge(mModelData, typeIndex);
             }
     logProj(" processAnalysisFiles - loaded");
         if(continueProcessingItem())
@@ -237,6 +237,10 @@ ScreenOptions::ScreenOptions(OovStringRef const buildConfig, ProjectReader &proj
         OptGuiShowOperBodyVarRelations, "ShowOperBodyVarRelationsCheckbutton")));
     mGuiOptionLookup.push_back(std::unique_ptr<Option>(new CheckOption(
         OptGuiShowRelationKey, "ShowRelationKeyCheckbutton")));
+    mGuiOptionLookup.push_back(std::unique_ptr<Option>(new CheckOption(
+        OptGuiLayeredDependencyLayout, "LayeredDependencyLayoutCheckbutton")));
+    mGuiOptionLookup.push_back(std::unique_ptr<Option>(new CheckOption(
+        OptGuiForceClassLayout, "ForceClassLayoutCheckbutton")));
     }
 
 void ScreenOptions::optionsToScreen() const
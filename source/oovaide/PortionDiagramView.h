@@ -25,6 +25,8 @@ class PortionDiagramView
 
         void initialize(const ModelData &modelData)
             {
+            mPortionDiagram.setLayeredLayout(mGuiOptions.getValueBool(
+                OptGuiLayeredDependencyLayout));
             mPortionDiagram.initialize(modelData);
             }
 
@@ -204,6 +204,7 @@ bool XmiParser::parse(char const * const buf)
     if(sDumpFile)
         fprintf(sLog.mFp, "---------- starting index = %d\n", mStartingModuleTypeIndex);
 #endif
+    mFirstModuleAssociationIndex = mModel.mAssociations.size();
     bool success = (parseXml(buf) == ERROR_NONE);
     if(success)
         {
@@ -613,7 +614,11 @@ ModelObject *XmiParser::findParentInStack(XmiElementTypes type, bool afterAdding
 
 void XmiParser::closeTypeElem(XmiElement const &elItem)
     {
-    ModelType *newType = static_cast<ModelType*>(elItem.mModelObject);
+    mergeType(static_cast<ModelType*>(elItem.mModelObject));
+    }
+
+void XmiParser::mergeType(ModelType *newType)
+    {
     ModelType *existingType = mModel.findType(newType->getName().c_str());
     if(existingType)
         {
@@ -856,10 +861,11 @@ void XmiParser::updateTypeIndices()
                 }
             }
         }
-    // Not real efficient to go through all, but there should not be all that many
-    // compared to the number of types.
-    for(auto &assoc : mModel.mAssociations)
+    // Only the associations from the current module can refer to the
+    // indices of the current module.
+    for(size_t ai=mFirstModuleAssociationIndex; ai<mModel.mAssociations.size(); ai++)
         {
+        auto &assoc = mModel.mAssociations[ai];
             for(auto const &iterChild : mFileTypeIndexMap)
                 {
                 if(iterChild.first == assoc->getChildModelId())
@@ -928,6 +934,96 @@ void XmiParser::updateTypeIndices()
         }
     }
 
+void XmiParser::offsetTypeIndex(ModelTypeRef &decl, int fileNextTypeIndex)
+    {
+    // Only indices that were read from the file are offset. Zero is the
+    // default index, and -1 is used for [else].
+    int id = decl.getDeclTypeModelId();
+    if(id > 0 && id < fileNextTypeIndex)
+        {
+        decl.setDeclTypeModelId(id + mStartingModuleTypeIndex - 1);
+        }
+    }
+
+void XmiParser::offsetTypeIndices(ModelData &fileModel, int fileNextTypeIndex)
+    {
+    int offset = mStartingModuleTypeIndex - 1;
+    for(auto &type : fileModel.mTypes)
+        {
+        int id = type->getModelId();
+        if(id > 0 && id < fileNextTypeIndex)
+            {
+            type->setModelId(id + offset);
+            }
+        if(type->getDataType() == DT_Class)
+            {
+            ModelClassifier *classifier = ModelClassifier::getClass(type.get());
+            for(auto &attr : classifier->getAttributes())
+                {
+                offsetTypeIndex(*attr, fileNextTypeIndex);
+                }
+            for(auto &oper : classifier->getOperations())
+                {
+                for(auto &param : oper->getParams())
+                    {
+                    offsetTypeIndex(*param, fileNextTypeIndex);
+                    }
+                for(auto &stmt : oper->getStatements())
+                    {
+                    if(stmt.getStatementType() == ST_Call ||
+                            stmt.getStatementType() == ST_VarRef)
+                        {
+                        offsetTypeIndex(stmt.getClassDecl(), fileNextTypeIndex);
+                        if(stmt.getStatementType() == ST_VarRef)
+                            {
+                            offsetTypeIndex(stmt.getVarDecl(), fileNextTypeIndex);
+                            }
+                        }
+                    }
+                for(auto &vd : oper->getBodyVarDeclarators())
+                    {
+                    offsetTypeIndex(*vd, fileNextTypeIndex);
+                    }
+                offsetTypeIndex(oper->getReturnType(), fileNextTypeIndex);
+                }
+            }
+        }
+    for(auto &assoc : fileModel.mAssociations)
+        {
+        int id = assoc->getChildModelId();
+        if(id > 0 && id < fileNextTypeIndex)
+            {
+            assoc->setChildModelId(id + offset);
+            }
+        id = assoc->getParentModelId();
+        if(id > 0 && id < fileNextTypeIndex)
+            {
+            assoc->setParentModelId(id + offset);
+            }
+        }
+    }
+
+void XmiParser::merge(ModelData &fileModel, int fileNextTypeIndex)
+    {
+    offsetTypeIndices(fileModel, fileNextTypeIndex);
+    mEndingModuleTypeIndex = mStartingModuleTypeIndex + fileNextTypeIndex - 2;
+    mFirstModuleAssociationIndex = mModel.mAssociations.size();
+    for(auto &mod : fileModel.mModules)
+        {
+        mModel.mModules.push_back(std::move(mod));
+        }
+    for(auto &assoc : fileModel.mAssociations)
+        {
+        mModel.mAssociations.push_back(std::move(assoc));
+        }
+    for(auto &type : fileModel.mTypes)
+        {
+        mergeType(type.release());
+        }
+    fileModel.clear();
+    updateTypeIndices();
+    }
+
 static bool loadXmiBuf(char const * const buf, ModelData &model, int &typeIndex)
     {
     XmiParser parser(model);
@@ -995,3 +1091,52 @@ bool loadXmiFile(File const &file, ModelData &graph, OovStringRef const fn, int
     return status.ok();
     };
 
+
+bool XmiFileModel::load(OovStringRef const fn)
+    {
+    File file;
+    OovStatus status = file.open(fn, "r");
+    int size = 0;
+    if(status.ok())
+        {
+        status = file.getFileSize(size);
+        }
+    if(status.ok())
+        {
+        std::vector<char> buf(size+1);
+        status = file.read(buf.data(), size);
+        if(status.ok())
+            {
+            buf[size] = 0;
+            // Start at one so that indices from the file can be told apart
+            // from default indices when the model is merged.
+            XmiParser parser(mModel);
+            parser.setStartingTypeIndex(1);
+            status.set(parser.parse(buf.data()), SC_Logic);
+            mNextTypeIndex = parser.getNextTypeIndex();
+            }
+        }
+    if(status.needReport())
+        {
+        OovString err = "Unable to read XMI file ";
+        err += fn;
+        status.report(ET_Error, err);
+        }
+    return status.ok();
+    }
+
+void XmiFileModel::merge(ModelData &model, int &typeIndex)
+    {
+    if(mNextTypeIndex > 0)
+        {
+        XmiParser parser(model);
+        parser.setStartingTypeIndex(typeIndex);
+        parser.merge(mModel, mNextTypeIndex);
+        typeIndex = parser.getNextTypeIndex();
+        }
+    }
+
+bool XmiFileModelLoader::processItem(size_t const &fileIndex)
+    {
+    return mFileModels[fileIndex].load(mFileNames[fileIndex]);
+    }
@@ -33,6 +33,7 @@
 #include <vector>
 #include "OovString.h"
 #include "File.h"
+#include "OovThreadedWaitQueue.h"
 
 
 enum XmiElementTypes
@@ -67,7 +68,7 @@ class XmiParser:private XmlParser
     public:
         XmiParser(ModelData &model):
             mModel(model), mCurrentClassifier(NULL), mStartingModuleTypeIndex(0),
-            mEndingModuleTypeIndex(0)
+            mEndingModuleTypeIndex(0), mFirstModuleAssociationIndex(0)
             {}
     public:
         bool parse(char const * const buf);
@@ -83,6 +84,14 @@ class XmiParser:private XmlParser
             }
         int getNextTypeIndex() const
             { return mEndingModuleTypeIndex+1; }
+        /// Merges a model that was parsed from a single file by a separate
+        /// parser that used a starting type index of one. The type indices
+        /// of the file model are moved to start at the starting type index of
+        /// this parser, and then the types are merged into this model the
+        /// same as if the file was parsed by this parser.
+        /// @param fileModel The model is empty after merging.
+        /// @param fileNextTypeIndex The next type index of the file parser.
+        void merge(ModelData &fileModel, int fileNextTypeIndex);
 
     private:
         ModelData &mModel;
@@ -96,8 +105,13 @@ class XmiParser:private XmlParser
         // These are the types that were loaded from the current module that
         // may need to have indices remapped.
         std::vector<ModelType*> mPotentialRemapIndicesTypes;
+        // The first association that was loaded from the current module.
+        size_t mFirstModuleAssociationIndex;
 
         void closeTypeElem(XmiElement const &elItem);
+        void mergeType(ModelType *newType);
+        void offsetTypeIndex(ModelTypeRef &decl, int fileNextTypeIndex);
+        void offsetTypeIndices(ModelData &fileModel, int fileNextTypeIndex);
         void updateDeclTypeIndices(ModelTypeRef &decl);
         void updateStatementTypeIndices(ModelStatements &stmt);
         void updateTypeIndices();
@@ -121,5 +135,47 @@ class XmiParser:private XmlParser
 
 bool loadXmiFile(File const &file, ModelData &model, OovStringRef const fn, int &typeIndex);
 
+/// A model that was loaded from a single XMI file. Since the model is not
+/// shared with other files, many files can be loaded at the same time, and
+/// then merged into the full model in file order.
+class XmiFileModel
+    {
+    public:
+        XmiFileModel():
+            mNextTypeIndex(0)
+            {}
+        /// This can be called from any thread.
+        bool load(OovStringRef const fn);
+        /// This must be called for each file in the same order that
+        /// loadXmiFile would have been called, and the typeIndex is updated
+        /// the same way, so the merged model is the same.
+        void merge(ModelData &model, int &typeIndex);
+
+    private:
+        ModelData mModel;
+        int mNextTypeIndex;
+    };
+
+/// Loads many XMI files into separate file models using multiple threads.
+/// Add the index of each file name as a task, and the file model for each
+/// file is at the same index.
+class XmiFileModelLoader:public ThreadedWorkWaitQueue<size_t, XmiFileModelLoader>
+    {
+    public:
+        /// @param fileNames These must not change until loading is complete.
+        XmiFileModelLoader(std::vector<std::string> const &fileNames):
+            mFileNames(fileNames), mFileModels(fileNames.size())
+            {}
+        XmiFileModel &getFileModel(size_t fileIndex)
+            { return mFileModels[fileIndex]; }
+
+        // Called by ThreadedWorkWaitQueue
+        bool processItem(size_t const &fileIndex);
+
+    private:
+        std::vector<std::string> const &mFileNames;
+        std::vector<XmiFileModel> mFileModels;
+    };
+
 #endif
 
@@ -49,8 +49,6 @@ a file such as the following.
 static char const sWhiteSpaceStr[] = " \t\n\r";
 static char const sTokenStr[] = " \t\n\r\"\'=<>";
 
-static bool sDeclarationElement = false;
-
 XmlError XmlParser::parseXml(char const * const buf)
     {
     XmlError errCode;
@@ -60,7 +58,7 @@ XmlError XmlParser::parseXml(char const * const buf)
         {
         p++;      // Skip '<'
         errCode = parseElem(p);
-        if(sDeclarationElement && p)
+        if(mDeclarationElement && p)
             {
             p = strchr(p, '<');
             if(buf)
@@ -137,7 +135,7 @@ XmlError XmlParser::parseElem(char const *&buf)
     XmlError errCode = parseName(buf, elemName, elemNameLen);
     if(errCode.isOK())
         {
-        sDeclarationElement = (elemName[0] == '?');
+        mDeclarationElement = (elemName[0] == '?');
         onOpenElem(elemName, elemNameLen);
         buf += elemNameLen;
         }
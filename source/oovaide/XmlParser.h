@@ -55,6 +55,9 @@ class XmlError
 class XmlParser
     {
     public:
+        XmlParser():
+            mDeclarationElement(false)
+            {}
         XmlError parseXml(char const * const buf);
         virtual ~XmlParser()
             {}
@@ -68,6 +71,10 @@ class XmlParser
             {}
 
     private:
+        /// This is a member so that many files can be parsed at the same
+        /// time on different threads.
+        bool mDeclarationElement;
+
         XmlError parseAttr(char const *&buf);
         XmlError parseElem(char const *&buf);
         XmlError parseElemValue(char const *& buf);